@@ -74,6 +74,7 @@ NukiBle::~NukiBle() {
     bleScanner->unsubscribe(this);
     bleScanner = nullptr;
   }
+  vEventGroupDelete(commandEvents);
 }
 
 void NukiBle::initialize(bool initAltConnect) {
@@ -1100,6 +1101,8 @@ void NukiBle::saveCredentials() {
   } else {
     logMessage("ERROR saving credentials", 1);
   }
+  //reload on next use, so RAM and NVS never differ
+  credentialsLoaded = false;
 }
 
 uint16_t NukiBle::getSecurityPincode() {
@@ -1142,11 +1145,18 @@ bool NukiBle::retrieveCredentials() {
   //TODO check on empty (invalid) credentials?
   unsigned char buff[6];
 
+  //valid credentials stay in RAM until they are saved or deleted again
+  if (credentialsLoaded) {
+    return true;
+  }
+
   if (takeNukiBleSemaphore("retr cred")) {
-    if ((preferences.getBytes(BLE_ADDRESS_STORE_NAME, buff, 6) > 0)
-        && (preferences.getBytes(SECRET_KEY_STORE_NAME, secretKeyK, 32) > 0)
-        && (preferences.getBytes(AUTH_ID_STORE_NAME, authorizationId, 4) > 0)
-       ) {
+    size_t addressLen = preferences.getBytes(BLE_ADDRESS_STORE_NAME, buff, 6);
+    size_t secretKeyLen = preferences.getBytes(SECRET_KEY_STORE_NAME, secretKeyK, 32);
+    size_t authIdLen = preferences.getBytes(AUTH_ID_STORE_NAME, authorizationId, 4);
+    credentialNvsReads += 3;
+
+    if (addressLen > 0 && secretKeyLen > 0 && authIdLen > 0) {
       bleAddress = BLEAddress(buff, 0);
 
       if (debugNukiConnect) {
@@ -1163,6 +1173,7 @@ bool NukiBle::retrieveCredentials() {
       }
 
       smartLockUltra = preferences.getBool(ULTRA_STORE_NAME, false);
+      credentialNvsReads += 2;
 
       if (isLockUltra()) {
         preferences.getBytes(ULTRA_PINCODE_STORE_NAME, &ultraPinCode, 4);
@@ -1183,6 +1194,7 @@ bool NukiBle::retrieveCredentials() {
       giveNukiBleSemaphore();
       return false;
     }
+    credentialsLoaded = true;
     giveNukiBleSemaphore();
   }
 
@@ -1198,6 +1210,7 @@ void NukiBle::deleteCredentials() {
     preferences.putBool(ULTRA_STORE_NAME, false);
     // preferences.remove(SECRET_KEY_STORE_NAME);
     // preferences.remove(AUTH_ID_STORE_NAME);
+    credentialsLoaded = false;
     giveNukiBleSemaphore();
   }
   if (debugNukiConnect) {
@@ -1406,12 +1419,18 @@ bool NukiBle::sendEncryptedMessage(Command commandIdentifier, const unsigned cha
   #     ADDITIONAL DATA (not encr)      #                    PLAIN DATA (encr)                             #
   #  nonce  # auth identifier # msg len # authorization identifier # command identifier # payload #  crc   #
   # 24 byte #    4 byte       # 2 byte  #      4 byte              #       2 byte       #  n byte # 2 byte #
+
+  The frame is composed in txFrame, the plain data is written behind the header and the MAC
+  and encrypted in place, so the buffer holds the complete message afterwards.
   */
 
-  //compose plain data
-  unsigned char plainData[6 + payloadLen] = {};
-  unsigned char plainDataWithCrc[8 + payloadLen] = {};
+  const uint16_t plainLen = 8 + payloadLen;
+  const uint16_t encrLen = plainLen + crypto_secretbox_MACBYTES;
+  unsigned char* additionalData = txFrame;
+  unsigned char* encrData = &txFrame[NUKI_FRAME_HEADER_SIZE];
+  unsigned char* plainData = &encrData[crypto_secretbox_MACBYTES];
 
+  //compose plain data
   if(encryptPairing) {
     plainData[0] = (deviceId >> (8 * 0)) & 0xff;
     plainData[1] = (deviceId >> (8 * 1)) & 0xff;
@@ -1424,20 +1443,17 @@ bool NukiBle::sendEncryptedMessage(Command commandIdentifier, const unsigned cha
   memcpy(&plainData[6], payload, payloadLen);
 
   //get crc over plain data
-  uint16_t dataCrc = calculateCrc((uint8_t*)plainData, 0, sizeof(plainData));
-
-  memcpy(&plainDataWithCrc[0], &plainData, sizeof(plainData));
-  memcpy(&plainDataWithCrc[sizeof(plainData)], &dataCrc, sizeof(dataCrc));
+  uint16_t dataCrc = calculateCrc((uint8_t*)plainData, 0, plainLen - 2);
+  memcpy(&plainData[plainLen - 2], &dataCrc, sizeof(dataCrc));
 
   if (debugNukiHexData) {
     logMessageVar("payloadlen: %d", payloadLen);
-    logMessageVar("sizeof(plainData): %d", sizeof(plainData));
+    logMessageVar("sizeof(plainData): %d", plainLen - 2);
     logMessageVar("CRC: %0.2x", dataCrc);
   }
-  printBuffer((byte*)plainDataWithCrc, sizeof(plainDataWithCrc), false, "Plain data with CRC: ", debugNukiHexData, logger);
+  printBuffer((byte*)plainData, plainLen, false, "Plain data with CRC: ", debugNukiHexData, logger);
 
   //compose additional data
-  unsigned char additionalData[30] = {};
   generateNonce(sentNonce, sizeof(sentNonce), debugNukiHexData);
 
   memcpy(&additionalData[0], sentNonce, sizeof(sentNonce));
@@ -1451,36 +1467,32 @@ bool NukiBle::sendEncryptedMessage(Command commandIdentifier, const unsigned cha
     memcpy(&additionalData[24], authorizationId, sizeof(authorizationId));
   }
 
-  //Encrypt plain data
-  unsigned char plainDataEncr[ sizeof(plainDataWithCrc) + crypto_secretbox_MACBYTES] = {0};
-  int encrMsgLen = encode(plainDataEncr, plainDataWithCrc, sizeof(plainDataWithCrc), sentNonce, secretKeyK, logger);
+  //Encrypt plain data in place, MAC and cipher text start right after the additional data
+  int encrMsgLen = encode(encrData, plainData, plainLen, sentNonce, secretKeyK, logger);
 
   if (encrMsgLen >= 0) {
-    int16_t length = sizeof(plainDataEncr);
+    int16_t length = encrLen;
     memcpy(&additionalData[28], &length, 2);
 
-    printBuffer((byte*)additionalData, 30, false, "Additional data: ", debugNukiHexData, logger);
+    printBuffer((byte*)additionalData, NUKI_FRAME_HEADER_SIZE, false, "Additional data: ", debugNukiHexData, logger);
     printBuffer((byte*)secretKeyK, sizeof(secretKeyK), false, "Encryption key (secretKey): ", debugNukiHexData, logger);
-    printBuffer((byte*)plainDataEncr, sizeof(plainDataEncr), false, "Plain data encrypted: ", debugNukiHexData, logger);
+    printBuffer((byte*)encrData, encrLen, false, "Plain data encrypted: ", debugNukiHexData, logger);
 
-    //compose complete message
-    unsigned char dataToSend[sizeof(additionalData) + sizeof(plainDataEncr)] = {};
-    memcpy(&dataToSend[0], additionalData, sizeof(additionalData));
-    memcpy(&dataToSend[30], plainDataEncr, sizeof(plainDataEncr));
+    const uint16_t frameLen = NUKI_FRAME_HEADER_SIZE + encrLen;
 
     if(encryptPairing) {
       if (connectBle(bleAddress, true)) {
-        printBuffer((byte*)dataToSend, sizeof(dataToSend), false, "Sending encrypted pairing message", debugNukiHexData, logger);
+        printBuffer((byte*)txFrame, frameLen, false, "Sending encrypted pairing message", debugNukiHexData, logger);
         encryptPairing = false;
         recieveEncrypted = true;
-        return pGdioCharacteristic->writeValue((uint8_t*)dataToSend, sizeof(dataToSend), true);
+        return pGdioCharacteristic->writeValue((uint8_t*)txFrame, frameLen, true);
       } else {
         logMessage("Send encr msg failed due to unable to connect", 2);
       }
     } else {
       if (connectBle(bleAddress, false)) {
-        printBuffer((byte*)dataToSend, sizeof(dataToSend), false, "Sending encrypted message", debugNukiHexData, logger);
-        return pUsdioCharacteristic->writeValue((uint8_t*)dataToSend, sizeof(dataToSend), true);
+        printBuffer((byte*)txFrame, frameLen, false, "Sending encrypted message", debugNukiHexData, logger);
+        return pUsdioCharacteristic->writeValue((uint8_t*)txFrame, frameLen, true);
       } else {
         logMessage("Send encr msg failed due to unable to connect", 2);
       }
@@ -1651,46 +1663,71 @@ void NukiBle::notifyCallback(BLERemoteCharacteristic* pBLERemoteCharacteristic,
     uint16_t returnCode = ((uint16_t)recData[1] << 8) | recData[0];
     crcCheckOke = crcValid(recData, length, debugNukiCommunication, logger);
     if (crcCheckOke) {
-      unsigned char plainData[200];
-      memcpy(plainData, &recData[2], length - 4);
-      handleReturnMessage((Command)returnCode, plainData, length - 4);
+      //payload is passed as view into the received data
+      handleReturnMessage((Command)returnCode, &recData[2], length - 4);
     }
   } else if (pBLERemoteCharacteristic->getUUID() == userDataUUID || (pBLERemoteCharacteristic->getUUID() == gdioUltraUUID && recieveEncrypted)) {
     if (pBLERemoteCharacteristic->getUUID() == gdioUltraUUID) {
       recieveEncrypted = false;
     }
     //handle encrypted msg
-    unsigned char recNonce[crypto_secretbox_NONCEBYTES];
-    unsigned char recAuthorizationId[4];
-    unsigned char recMsgLen[2];
-    memcpy(recNonce, &recData[0], crypto_secretbox_NONCEBYTES);
-    memcpy(recAuthorizationId, &recData[crypto_secretbox_NONCEBYTES], 4);
-    memcpy(recMsgLen, &recData[crypto_secretbox_NONCEBYTES + 4], 2);
     uint16_t encrMsgLen = 0;
-    memcpy(&encrMsgLen, recMsgLen, 2);
-    unsigned char encrData[encrMsgLen];
-    memcpy(&encrData, &recData[crypto_secretbox_NONCEBYTES + 6], encrMsgLen);
+    if (length >= NUKI_FRAME_HEADER_SIZE) {
+      memcpy(&encrMsgLen, &recData[crypto_secretbox_NONCEBYTES + 4], 2);
+    }
+    if (length > sizeof(rxFrame) || encrMsgLen < crypto_secretbox_MACBYTES + 8 || NUKI_FRAME_HEADER_SIZE + encrMsgLen > length) {
+      logMessageVar("Invalid encrypted msg, len: %d", (unsigned int)length, 2);
+      crcCheckOke = false;
+      xEventGroupSetBits(commandEvents, CMD_EVENT_MSG_RECEIVED);
+      return;
+    }
 
-    unsigned char decrData[encrMsgLen - crypto_secretbox_MACBYTES];
-    decode(decrData, encrData, encrMsgLen, recNonce, secretKeyK, logger);
+    //the frame is decrypted in place, the plain data ends up right behind the MAC
+    memcpy(rxFrame, recData, NUKI_FRAME_HEADER_SIZE + encrMsgLen);
+    unsigned char* recNonce = rxFrame;
+    unsigned char* recAuthorizationId = &rxFrame[crypto_secretbox_NONCEBYTES];
+    unsigned char* encrData = &rxFrame[NUKI_FRAME_HEADER_SIZE];
+    unsigned char* decrData = &encrData[crypto_secretbox_MACBYTES];
+    const uint16_t decrLen = encrMsgLen - crypto_secretbox_MACBYTES;
 
     if (debugNukiCommunication) {
       logMessageVar("Received encrypted msg, len: %d", encrMsgLen);
     }
-    printBuffer(recNonce, sizeof(recNonce), false, "received nonce", debugNukiHexData, logger);
-    printBuffer(recAuthorizationId, sizeof(recAuthorizationId), false, "Received AuthorizationId", debugNukiHexData, logger);
-    printBuffer(encrData, sizeof(encrData), false, "Rec encrypted data", debugNukiHexData, logger);
-    printBuffer(decrData, sizeof(decrData), false, "Decrypted data", debugNukiHexData, logger);
+    printBuffer(recNonce, crypto_secretbox_NONCEBYTES, false, "received nonce", debugNukiHexData, logger);
+    printBuffer(recAuthorizationId, 4, false, "Received AuthorizationId", debugNukiHexData, logger);
+    printBuffer(encrData, encrMsgLen, false, "Rec encrypted data", debugNukiHexData, logger);
 
-    crcCheckOke = crcValid(decrData, sizeof(decrData), debugNukiCommunication, logger);
-    if (crcCheckOke) {
-      uint16_t returnCode = 0;
-      memcpy(&returnCode, &decrData[4], 2);
-      unsigned char payload[sizeof(decrData) - 8];
-      memcpy(&payload, &decrData[6], sizeof(payload));
-      handleReturnMessage((Command)returnCode, payload, sizeof(payload));
+    if (decode(decrData, encrData, encrMsgLen, recNonce, secretKeyK, logger) < 0) {
+      crcCheckOke = false;
+    } else {
+      printBuffer(decrData, decrLen, false, "Decrypted data", debugNukiHexData, logger);
+
+      crcCheckOke = crcValid(decrData, decrLen, debugNukiCommunication, logger);
+      if (crcCheckOke) {
+        uint16_t returnCode = 0;
+        memcpy(&returnCode, &decrData[4], 2);
+        //payload is passed as view into rxFrame, valid until the next notification
+        handleReturnMessage((Command)returnCode, &decrData[6], decrLen - 8);
+      }
     }
   }
+  xEventGroupSetBits(commandEvents, CMD_EVENT_MSG_RECEIVED);
+}
+
+void NukiBle::waitForCommandProgress() {
+  #ifndef NUKI_64BIT_TIME
+  unsigned long elapsed = millis() - timeNow;
+  #else
+  int64_t elapsed = (esp_timer_get_time() / 1000) - timeNow;
+  #endif
+  //wake up right after the command timeout so the state machine can report it
+  uint32_t waitMs = CMD_WAIT_SLICE;
+  if (elapsed >= CMD_TIMEOUT) {
+    waitMs = 1;
+  } else if (CMD_TIMEOUT - elapsed + 1 < waitMs) {
+    waitMs = CMD_TIMEOUT - elapsed + 1;
+  }
+  xEventGroupWaitBits(commandEvents, CMD_EVENT_MSG_RECEIVED, pdTRUE, pdFALSE, pdMS_TO_TICKS(waitMs));
 }
 
 void NukiBle::handleReturnMessage(Command returnCode, unsigned char* data, uint16_t dataLen) {
@@ -1881,6 +1918,14 @@ void NukiBle::setEventHandler(SmartlockEventHandler* handler) {
   eventHandler = handler;
 }
 
+uint32_t NukiBle::getCredentialNvsReads() const {
+  return credentialNvsReads;
+}
+
+uint32_t NukiBle::getLastCommandNvsReads() const {
+  return lastCommandNvsReads;
+}
+
 bool NukiBle::isPairedWithLock() const {
   return isPaired;
 };
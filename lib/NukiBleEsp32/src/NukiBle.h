@@ -17,6 +17,7 @@
 #include "Arduino.h"
 #include <Preferences.h>
 #include <esp_task_wdt.h>
+#include "freertos/event_groups.h"
 #include <BleInterfaces.h>
 #include <atomic>
 #include <string>
@@ -27,6 +28,12 @@
 #define CMD_TIMEOUT 10000
 #define PAIRING_TIMEOUT 30000
 #define HEARTBEAT_TIMEOUT 30000
+#define CMD_WAIT_SLICE 1000 //max ms executeAction() blocks for an answer before checking timeouts and resetting the watchdog
+
+#define CMD_EVENT_MSG_RECEIVED BIT0
+
+#define NUKI_FRAME_HEADER_SIZE (crypto_secretbox_NONCEBYTES + 6) //nonce, authorization id and length of an encrypted message
+#define NUKI_FRAME_BUFFER_SIZE (NUKI_FRAME_HEADER_SIZE + crypto_secretbox_MACBYTES + 8 + 255) //largest encrypted message incl. 255 byte payload
 
 #ifdef CONFIG_IDF_TARGET_ESP32P4
 typedef enum {
@@ -133,6 +140,17 @@ class NukiBle : public BLEClientCallbacks, public BleScanner::Subscriber {
      */
     bool isLockUltra() const;
 
+    /**
+     * @brief Returns the number of NVS reads done to load the pairing credentials since boot
+     */
+    uint32_t getCredentialNvsReads() const;
+
+    /**
+     * @brief Returns the number of NVS reads done to load the pairing credentials for the last
+     * command, 0 if they were already held in RAM
+     */
+    uint32_t getLastCommandNvsReads() const;
+
     /**
      * @brief Returns the log entry count. Only available after executing retreiveLogEntries.
      */
@@ -435,6 +453,9 @@ class NukiBle : public BLEClientCallbacks, public BleScanner::Subscriber {
     #else
     SemaphoreHandle_t nukiBleSemaphore = xSemaphoreCreateRecursiveMutex();
     #endif
+    //set by notifyCallback() when a message from the lock has been handled, executeAction() waits for it
+    EventGroupHandle_t commandEvents = xEventGroupCreate();
+    void waitForCommandProgress();
     bool takeNukiBleSemaphore(std::string taker);
     std::string owner = "free";
     void giveNukiBleSemaphore();
@@ -510,6 +531,9 @@ class NukiBle : public BLEClientCallbacks, public BleScanner::Subscriber {
 
     BleScanner::Publisher* bleScanner = nullptr;
     bool isPaired = false;
+    bool credentialsLoaded = false; //credentials held in RAM, cleared by saveCredentials() and deleteCredentials()
+    uint32_t credentialNvsReads = 0;
+    uint32_t lastCommandNvsReads = 0;
 
     Nuki::SmartlockEventHandler* eventHandler;
 
@@ -526,6 +550,9 @@ class NukiBle : public BLEClientCallbacks, public BleScanner::Subscriber {
     unsigned char secretKeyK[32] = {0x00};
 
     unsigned char sentNonce[crypto_secretbox_NONCEBYTES] = {};
+    //scratch buffers holding a complete encrypted message, encrypted / decrypted in place
+    unsigned char txFrame[NUKI_FRAME_BUFFER_SIZE] = {}; //used by sendEncryptedMessage()
+    unsigned char rxFrame[NUKI_FRAME_BUFFER_SIZE] = {}; //used by notifyCallback(), payload handlers get a view into it
 
     uint16_t nrOfKeypadCodes = 0;
     uint8_t nrOfReceivedKeypadCodes = 0;
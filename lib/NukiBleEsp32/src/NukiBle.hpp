@@ -17,7 +17,10 @@ Nuki::CmdResult NukiBle::executeAction(const TDeviceAction action) {
   if (debugNukiConnect) {
     logMessage("************************ CHECK PAIRED ************************");
   }
-  if (retrieveCredentials()) {
+  uint32_t nvsReadsBefore = credentialNvsReads;
+  bool credentialsRetrieved = retrieveCredentials();
+  lastCommandNvsReads = credentialNvsReads - nvsReadsBefore;
+  if (credentialsRetrieved) {
     if (debugNukiConnect) {
       logMessage("Credentials retrieved from preferences, ready for commands");
     }
@@ -32,10 +35,13 @@ Nuki::CmdResult NukiBle::executeAction(const TDeviceAction action) {
     if (debugNukiCommunication) {
       logMessageVar("Start executing: %02x ", (unsigned int)action.command);
     }
+    //forget answers that arrived outside of a command
+    xEventGroupClearBits(commandEvents, CMD_EVENT_MSG_RECEIVED);
 
     while (1) {
       extendDisconnectTimeout();
       
+      Nuki::CommandState stateBefore = nukiCommandState;
       Nuki::CmdResult result;
       if (action.cmdType == Nuki::CommandType::Command) {
         result = cmdStateMachine(action);
@@ -66,7 +72,11 @@ Nuki::CmdResult NukiBle::executeAction(const TDeviceAction action) {
       #ifndef NUKI_NO_WDT_RESET
       esp_task_wdt_reset();
       #endif
-      delay(10);
+      //a state that was just entered (e.g. challenge received) is handled right away,
+      //otherwise the state machine waits for the lock to answer
+      if (nukiCommandState == stateBefore) {
+        waitForCommandProgress();
+      }
     }
   }
   return Nuki::CmdResult::Failed;
@@ -1,7 +1,10 @@
 #include "NukiUtils.h"
 
 #include "sodium/crypto_secretbox.h"
+#ifdef NUKI_CRC16_BITWISE
 #include "Crc16.h"
+#endif
+#include <array>
 
 
 namespace Nuki {
@@ -100,11 +103,36 @@ void generateNonce(unsigned char* hexArray, uint8_t nrOfBytes, bool debug, Print
   printBuffer((byte*)hexArray, nrOfBytes, false, "Nonce", debug, Log);
 }
 
+#ifndef NUKI_CRC16_BITWISE
+// CRC of every single byte value, generated at compile time for poly 0x1021
+static constexpr std::array<uint16_t, 256> makeCrcTable() {
+  std::array<uint16_t, 256> table = {};
+  for (uint16_t i = 0; i < 256; i++) {
+    uint16_t crc = i << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+static constexpr std::array<uint16_t, 256> crcTable = makeCrcTable();
+#endif
+
 unsigned int calculateCrc(uint8_t* data, uint8_t start, uint16_t length) {
+  // CCITT-False:	width=16 poly=0x1021 init=0xffff refin=false refout=false xorout=0x0000 check=0x29b1
+  #ifdef NUKI_CRC16_BITWISE
   Crc16 crcObj;
   crcObj.clearCrc();
-  // CCITT-False:	width=16 poly=0x1021 init=0xffff refin=false refout=false xorout=0x0000 check=0x29b1
   return crcObj.fastCrc(data, start, length, false, false, 0x1021, 0xffff, 0x0000, 0x8000, 0xffff);
+  #else
+  uint16_t crc = 0xffff;
+  for (uint16_t i = start; i < start + length; i++) {
+    crc = (crc << 8) ^ crcTable[(crc >> 8) ^ data[i]];
+  }
+  return crc;
+  #endif
 }
 
 bool crcValid(uint8_t* pData, uint16_t length, bool debug, Print* Log) {
@@ -0,0 +1,92 @@
+""" PlatformIO PRE script to embed the gzipped web assets from web/ into src/WebAssets.h
+
+Can also be run directly: python pio_web_assets.py
+"""
+
+import gzip, hashlib, os
+
+try:
+    Import("env")  # type: ignore
+    project_dir = env["PROJECT_DIR"]  # type: ignore
+except NameError:
+    project_dir = os.path.dirname(os.path.abspath(__file__))
+
+# served path, source file, content type
+ASSETS = [
+    ("/style.css", "web/style.css", "text/css"),
+    ("/app.js", "web/app.js", "application/javascript"),
+]
+
+OUTPUT = "src/WebAssets.h"
+
+
+def symbol(path):
+    """ "/style.css" -> "STYLE_CSS" """
+    return path.strip("/").replace(".", "_").replace("-", "_").upper()
+
+
+def camel(path):
+    """ "/style.css" -> "StyleCss" """
+    return "".join(part.capitalize() for part in symbol(path).split("_"))
+
+
+def generate():
+    lines = [
+        "#pragma once",
+        "",
+        "// Generated by pio_web_assets.py from the files in web/, do not edit.",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "/**",
+        " * @brief Gzipped static file of the web configurator.",
+        " */",
+        "struct WebAsset",
+        "{",
+        "    const char *path;        // Request path",
+        "    const char *contentType; // Content type of the uncompressed file",
+        "    const char *etag;        // Strong ETag incl. quotes",
+        "    const uint8_t *data;     // Gzipped content",
+        "    size_t size;             // Length of data",
+        "};",
+        "",
+    ]
+    table = []
+
+    for path, source, content_type in ASSETS:
+        with open(os.path.join(project_dir, source), "rb") as f:
+            raw = f.read()
+
+        # mtime=0 keeps the output (and the ETag) stable between builds
+        data = gzip.compress(raw, compresslevel=9, mtime=0)
+        version = hashlib.sha1(raw).hexdigest()[:16]
+        name = "webAsset" + camel(path)
+
+        lines.append(f"// {source}: {len(raw)} bytes, {len(data)} bytes gzipped")
+        lines.append(f'#define WEB_ASSET_{symbol(path)}_VERSION "{version}"')
+        lines.append(f"static const uint8_t {name}[] PROGMEM = {{")
+        for i in range(0, len(data), 16):
+            lines.append("    " + ", ".join(f"0x{b:02x}" for b in data[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+
+        table.append(f'    {{"{path}", "{content_type}", "\\"" WEB_ASSET_{symbol(path)}_VERSION "\\"", {name}, sizeof({name})}},')
+
+    lines.append("static const WebAsset webAssets[] = {")
+    lines.extend(table)
+    lines.append("};")
+    lines.append("")
+
+    content = "\n".join(lines)
+    output = os.path.join(project_dir, OUTPUT)
+    if os.path.exists(output):
+        with open(output, "r") as f:
+            if f.read() == content:
+                return
+
+    with open(output, "w", newline="\n") as f:
+        f.write(content)
+    print(f">>> [INFO] Web assets written to {OUTPUT}")
+
+
+generate()
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+#define CHUNKED_RESPONSE_BUFFER_SIZE 1024 // bytes collected before a chunk is sent
+
+/**
+ * @brief Print target that streams a response body in chunks.
+ *
+ * Output is collected in a fixed buffer and sent with chunked transfer encoding
+ * whenever the buffer is full, so responses of any size need no heap.
+ * Used for log queries and for all HTML pages of the web configurator.
+ * Call begin() to send the headers and end() to terminate the response.
+ */
+class ChunkedResponse : public Print
+{
+public:
+    explicit ChunkedResponse(WebServer *server) : _server(server) {}
+
+    /**
+     * @brief Sends status and headers, additional headers must be set before.
+     *
+     * @param code HTTP status code.
+     * @param contentType Content type of the body.
+     */
+    void begin(int code, const char *contentType)
+    {
+        _server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+        _server->send(code, contentType, "");
+    }
+
+    /**
+     * @brief Sends the buffered data and the terminating empty chunk.
+     */
+    void end()
+    {
+        flush();
+        _server->sendContent("");
+    }
+
+    /**
+     * @brief Sends the buffered data as one chunk.
+     */
+    void flush() override
+    {
+        if (_len > 0)
+        {
+            _server->sendContent(_buffer, _len);
+            _len = 0;
+        }
+    }
+
+    size_t write(uint8_t c) override
+    {
+        return write(&c, 1);
+    }
+
+    size_t write(const uint8_t *data, size_t size) override
+    {
+        size_t remaining = size;
+        while (remaining > 0)
+        {
+            size_t n = std::min(remaining, sizeof(_buffer) - _len);
+            memcpy(_buffer + _len, data, n);
+            _len += n;
+            data += n;
+            remaining -= n;
+            if (_len == sizeof(_buffer))
+            {
+                flush();
+            }
+        }
+        return size;
+    }
+
+    /**
+     * @brief Appends anything printable, lets page builders write like into a String.
+     */
+    template <typename T>
+    ChunkedResponse &operator+=(const T &value)
+    {
+        print(value);
+        return *this;
+    }
+
+private:
+    WebServer *_server;                         // Server sending the response
+    char _buffer[CHUNKED_RESPONSE_BUFFER_SIZE]; // Data not sent yet
+    size_t _len = 0;                            // Bytes in _buffer
+};
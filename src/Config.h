@@ -7,12 +7,39 @@
 
 #define NUKI_TASK_SIZE 8192
 #define NETWORK_TASK_SIZE 6144
-#define WEBCFGSERVER_TASK_SIZE 6144
+#define WEBCFGSERVER_TASK_SIZE 9216 // log queries and the chunked page writer keep ~2.3 KB of buffers on this stack
+#define REST_API_TASK_SIZE 6144
+#define NETWORK_SERVICE_PROBE_TASK_SIZE 6144
+#define HAR_SENDER_TASK_SIZE 6144
 
 #define WEBCFGSERVER_PORT 80
 #define REST_SERVER_PORT 8080
+#define REST_API_POLL_INTERVAL 2 // ms between two WebServer::handleClient() calls of the REST API task
 #define CHAR_BUFFER_SIZE 4096
 
+#define NETWORK_SERVICE_CHECK_INTERVAL 30000 // ms between two network service checks
+#define NETWORK_SERVICE_SETTLE_TIME 1000     // ms to wait after restarting services before re-checking
+#define NETWORK_SERVICE_PROBE_TIMEOUT 10000  // ms after which a running service probe counts as failed
+#define NETWORK_SERVICE_REQUEST_TIMEOUT 2000 // ms connect/response timeout of a single probe request
+
+#define HAR_QUEUE_SIZE 24        // max. number of pending Home Automation reports
+#define HAR_KEY_MAX_LEN 64       // max. length of a Home Automation key / param (see WebCfgServer)
+#define HAR_VALUE_MAX_LEN 80     // max. length of a reported value
+#define HAR_REQUEST_TIMEOUT 3000 // ms connect/response timeout of a single REST report
+#define HAR_BULK_MAX_SIZE 768    // max. size of a serialized JSON bulk report
+#define HAR_BULK_RETRY_MIN 2000  // ms before the first retry of a failed JSON bulk report
+#define HAR_BULK_RETRY_MAX 60000 // upper limit of the JSON bulk report retry delay (ms)
+
+#define LOCK_ACTION_QUEUE_SIZE 8          // lock action requests kept for dispatch and status lookup
+#define LOCK_ACTION_WAIT_POLL_INTERVAL 20 // ms between two checks while a REST request waits for its lock action
+#define LOCK_ACTION_MAX_WAIT 3000         // max. ms a REST request may wait for its lock action, the REST server handles no other request meanwhile
+
+#define EVENT_STREAM_MAX_CLIENTS 4            // upper limit of the configurable number of event stream clients
+#define EVENT_STREAM_DEFAULT_CLIENTS 2        // event stream clients allowed by default
+#define EVENT_STREAM_BUFFER_SIZE 1024         // bytes queued per event stream client, a client that falls behind is dropped
+#define EVENT_STREAM_WRITE_TIMEOUT 200        // ms a write to an event stream client may block
+#define EVENT_STREAM_HEARTBEAT_INTERVAL 15000 // ms between two heartbeat events
+
 #define MAX_AUTHLOG 5
 #define MAX_KEYPAD 10
 #define MAX_TIMECONTROL 10
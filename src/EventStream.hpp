@@ -0,0 +1,203 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <WiFiClient.h>
+#include "Config.h"
+#include "EspMillis.h"
+
+/**
+ * @brief Server-Sent Events (text/event-stream) clients of the REST API.
+ *
+ * A request is taken over by accept(), the socket stays open after the WebServer
+ * finished the request. publish() may be called from any task, it only appends
+ * the event to a fixed buffer per client. loop() runs in the REST API task and
+ * writes the buffers to the sockets, removes closed connections and sends a
+ * heartbeat. A client whose buffer overflows is dropped instead of blocking the
+ * publisher.
+ */
+class EventStream
+{
+public:
+    EventStream() : _semaphore(xSemaphoreCreateMutex()) {}
+
+    /**
+     * @brief Sets how many clients may be connected at the same time.
+     *
+     * @param maxClients 0 disables the stream, values above EVENT_STREAM_MAX_CLIENTS are capped.
+     */
+    void setMaxClients(uint8_t maxClients)
+    {
+        _maxClients = std::min(maxClients, (uint8_t)EVENT_STREAM_MAX_CLIENTS);
+    }
+
+    /**
+     * @brief Takes over the current request of the server as event stream client.
+     *
+     * @param server Server handling the request, its client is answered with the stream headers.
+     * @param event Name of the first event for the new client, e.g. the current state, may be nullptr.
+     * @param data Data of the first event.
+     * @return false if the client limit is reached, nothing was sent then.
+     */
+    bool accept(WebServer &server, const char *event, const char *data)
+    {
+        Client *slot = nullptr;
+        for (uint8_t i = 0; i < _maxClients; i++)
+        {
+            if (!_clients[i].active)
+            {
+                slot = &_clients[i];
+                break;
+            }
+        }
+        if (slot == nullptr)
+        {
+            return false;
+        }
+
+        xSemaphoreTake(_semaphore, portMAX_DELAY);
+        slot->client = server.client();
+        slot->client.setNoDelay(true);
+        slot->client.setTimeout(EVENT_STREAM_WRITE_TIMEOUT);
+        slot->len = 0;
+        slot->active = true;
+        append(*slot, "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\nConnection: keep-alive\r\n\r\nretry: 5000\n\n");
+        if (event != nullptr)
+        {
+            appendEvent(*slot, event, data);
+        }
+        xSemaphoreGive(_semaphore);
+
+        // the stream owns the socket now, let the WebServer go on with the next request
+        server.client().stop();
+        return true;
+    }
+
+    /**
+     * @brief Queues an event for all connected clients.
+     *
+     * @param event Event name.
+     * @param data Event data, a single line (e.g. serialized JSON).
+     */
+    void publish(const char *event, const char *data)
+    {
+        xSemaphoreTake(_semaphore, portMAX_DELAY);
+        for (Client &client : _clients)
+        {
+            if (client.active)
+            {
+                appendEvent(client, event, data);
+            }
+        }
+        xSemaphoreGive(_semaphore);
+    }
+
+    /**
+     * @brief Sends queued events and the heartbeat, call regularly from the REST API task.
+     */
+    void loop()
+    {
+        bool heartbeat = espMillis() - _heartbeatTs >= EVENT_STREAM_HEARTBEAT_INTERVAL;
+        if (heartbeat)
+        {
+            _heartbeatTs = espMillis();
+            char data[32];
+            snprintf(data, sizeof(data), "{\"uptime\":%lld}", espMillis() / 1000);
+            publish("heartbeat", data);
+        }
+
+        for (Client &client : _clients)
+        {
+            if (!client.active)
+            {
+                continue;
+            }
+
+            xSemaphoreTake(_semaphore, portMAX_DELAY);
+            size_t len = client.len;
+            memcpy(_sendBuffer, client.buffer, len);
+            client.len = 0;
+            bool overflow = client.overflow;
+            xSemaphoreGive(_semaphore);
+
+            if (overflow || !client.client.connected() || (len > 0 && client.client.write((const uint8_t *)_sendBuffer, len) != len))
+            {
+                remove(client);
+            }
+        }
+    }
+
+    /**
+     * @brief Number of connected clients.
+     */
+    uint8_t clientCount() const
+    {
+        uint8_t count = 0;
+        for (const Client &client : _clients)
+        {
+            count += client.active ? 1 : 0;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Number of clients dropped because they could not keep up.
+     */
+    uint32_t droppedCount() const
+    {
+        return _dropped;
+    }
+
+private:
+    struct Client
+    {
+        WiFiClient client;                     // Open stream connection
+        char buffer[EVENT_STREAM_BUFFER_SIZE]; // Events not sent yet
+        size_t len = 0;                        // Bytes in buffer
+        bool active = false;                   // Whether the slot is in use
+        bool overflow = false;                 // An event did not fit, the client is dropped
+    };
+
+    Client _clients[EVENT_STREAM_MAX_CLIENTS];  // Client slots
+    char _sendBuffer[EVENT_STREAM_BUFFER_SIZE]; // Copy of a client buffer while it is written, used by loop() only
+    SemaphoreHandle_t _semaphore;               // Guards the client buffers
+    uint8_t _maxClients = 0;                    // Configured client limit
+    int64_t _heartbeatTs = 0;                   // Time of the last heartbeat
+    uint32_t _dropped = 0;                      // Clients dropped because of a full buffer
+
+    void appendEvent(Client &client, const char *event, const char *data)
+    {
+        size_t needed = strlen("event: \ndata: \n\n") + strlen(event) + strlen(data);
+        if (client.len + needed > sizeof(client.buffer))
+        {
+            client.overflow = true;
+            return;
+        }
+        append(client, "event: ");
+        append(client, event);
+        append(client, "\ndata: ");
+        append(client, data);
+        append(client, "\n\n");
+    }
+
+    static void append(Client &client, const char *str)
+    {
+        size_t n = std::min(strlen(str), sizeof(client.buffer) - client.len);
+        memcpy(client.buffer + client.len, str, n);
+        client.len += n;
+    }
+
+    void remove(Client &client)
+    {
+        if (client.overflow)
+        {
+            _dropped++;
+        }
+        client.client.stop();
+        xSemaphoreTake(_semaphore, portMAX_DELAY);
+        client.active = false;
+        client.overflow = false;
+        client.len = 0;
+        xSemaphoreGive(_semaphore);
+    }
+};
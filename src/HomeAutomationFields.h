@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include "Config.h"
+
+/**
+ * @brief Values that can be reported to the Home Automation system.
+ *
+ * Each field has a configurable key (REST path) and param (query / UDP parameter).
+ */
+enum class HarField : uint8_t
+{
+    State,                 // HA state path (only used by the network service check)
+    RemoteAccessState,     //
+    WifiRssi,              //
+    Uptime,                //
+    RestartReasonFw,       //
+    RestartReasonEsp,      //
+    BridgeVersion,         //
+    BridgeBuild,           //
+    FreeHeap,              //
+    BleAddress,            //
+    BleStrength,           //
+    BleRssi,               //
+    LockState,             //
+    LockNgoState,          //
+    LockTrigger,           //
+    LockNightMode,         //
+    LockCompletionStatus,  //
+    DoorSensorState,       //
+    DoorSensorCritical,    //
+    KeypadCritical,        //
+    LockBatteryCritical,   //
+    LockBatteryLevel,      //
+    LockBatteryCharging,   //
+    BatteryVoltage,        //
+    BatteryDrain,          //
+    BatteryMaxTurnCurrent, //
+    BatteryLockDistance,   //
+    Count                  // Number of fields, keep last
+};
+
+/**
+ * @brief In-RAM copy of the key and param preference of a single HAR field.
+ */
+struct HarFieldConfig
+{
+    char key[HAR_KEY_MAX_LEN + 1];   // REST path, empty if not configured
+    char param[HAR_KEY_MAX_LEN + 1]; // Query / UDP parameter, empty if not configured
+};
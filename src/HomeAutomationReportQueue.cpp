@@ -0,0 +1,82 @@
+#include "HomeAutomationReportQueue.h"
+
+HomeAutomationReportQueue::HomeAutomationReportQueue()
+{
+    _mutex = xSemaphoreCreateMutex();
+}
+
+HomeAutomationReportQueue::~HomeAutomationReportQueue()
+{
+    vSemaphoreDelete(_mutex);
+}
+
+bool HomeAutomationReportQueue::push(const char *key, const char *param, const char *value)
+{
+    if (!key)
+        key = "";
+    if (!param)
+        param = "";
+    if (!value)
+        value = "";
+
+    bool dropped = false;
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    _pushed++;
+
+    // Coalesce with a queued report for the same field
+    for (size_t i = 0; i < _count; i++)
+    {
+        HomeAutomationReport &report = _reports[(_head + i) % HAR_QUEUE_SIZE];
+        if (strcmp(report.key, key) == 0 && strcmp(report.param, param) == 0)
+        {
+            strlcpy(report.value, value, sizeof(report.value));
+            _coalesced++;
+            xSemaphoreGive(_mutex);
+            return true;
+        }
+    }
+
+    if (_count == HAR_QUEUE_SIZE)
+    {
+        // drop oldest
+        _head = (_head + 1) % HAR_QUEUE_SIZE;
+        _count--;
+        _dropped++;
+        dropped = true;
+    }
+
+    HomeAutomationReport &report = _reports[(_head + _count) % HAR_QUEUE_SIZE];
+    strlcpy(report.key, key, sizeof(report.key));
+    strlcpy(report.param, param, sizeof(report.param));
+    strlcpy(report.value, value, sizeof(report.value));
+    _count++;
+
+    xSemaphoreGive(_mutex);
+    return !dropped;
+}
+
+bool HomeAutomationReportQueue::pop(HomeAutomationReport &report)
+{
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    if (_count == 0)
+    {
+        xSemaphoreGive(_mutex);
+        return false;
+    }
+
+    memcpy(&report, &_reports[_head], sizeof(HomeAutomationReport));
+    _head = (_head + 1) % HAR_QUEUE_SIZE;
+    _count--;
+
+    xSemaphoreGive(_mutex);
+    return true;
+}
+
+size_t HomeAutomationReportQueue::size()
+{
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    size_t count = _count;
+    xSemaphoreGive(_mutex);
+    return count;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstdint>
+#include "Config.h"
+
+/**
+ * @brief A single value to be reported to the Home Automation system.
+ */
+struct HomeAutomationReport
+{
+    char key[HAR_KEY_MAX_LEN + 1];     // REST path (REST mode)
+    char param[HAR_KEY_MAX_LEN + 1];   // Query / UDP parameter
+    char value[HAR_VALUE_MAX_LEN + 1]; // Value as string
+};
+
+/**
+ * @brief Fixed-capacity, thread-safe ring buffer of pending Home Automation reports.
+ *
+ * Producers (Nuki and network task) push reports without touching the network.
+ * A report whose key and param are already waiting in the queue replaces the queued
+ * value instead of occupying a new slot, so only the latest value of a field is sent.
+ * If the queue is full, the oldest report is dropped.
+ */
+class HomeAutomationReportQueue
+{
+public:
+    HomeAutomationReportQueue();
+
+    virtual ~HomeAutomationReportQueue();
+
+    /**
+     * @brief Adds a report or updates the value of an already queued one.
+     *
+     * @param key REST path (may be empty in UDP mode).
+     * @param param Query / UDP parameter (may be empty in REST mode).
+     * @param value Value to report.
+     * @return false if the oldest report had to be dropped to make room.
+     */
+    bool push(const char *key, const char *param, const char *value);
+
+    /**
+     * @brief Removes the oldest report from the queue.
+     *
+     * @param report Receives the report.
+     * @return true if a report was available.
+     */
+    bool pop(HomeAutomationReport &report);
+
+    /**
+     * @brief Number of queued reports.
+     */
+    size_t size();
+
+    uint32_t pushedCount() const { return _pushed; }       // Reports handed to push()
+    uint32_t coalescedCount() const { return _coalesced; } // Reports merged into an already queued one
+    uint32_t droppedCount() const { return _dropped; }     // Reports dropped because the queue was full
+
+private:
+    HomeAutomationReport _reports[HAR_QUEUE_SIZE]; // Ring buffer storage
+    size_t _head = 0;                              // Index of the oldest report
+    size_t _count = 0;                             // Number of queued reports
+    SemaphoreHandle_t _mutex;                      // Guards the ring buffer
+                                                   //
+    volatile uint32_t _pushed = 0;                 // Statistics
+    volatile uint32_t _coalesced = 0;              //
+    volatile uint32_t _dropped = 0;                //
+};
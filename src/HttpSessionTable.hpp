@@ -0,0 +1,258 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_random.h>
+
+#define HTTP_SESSION_SLOTS 8                                         // concurrent login sessions, the least recently used one is replaced
+#define HTTP_SESSION_TOKEN_SIZE 16                                   // random bytes per session
+#define HTTP_SESSION_COOKIE_SIZE (HTTP_SESSION_TOKEN_SIZE * 2 + 1)   // token as hex string incl. zero termination
+#define HTTP_SESSION_FILE_MAGIC 0x53534E42                           // start of the persisted table
+#define HTTP_SESSION_SAVE_INTERVAL 10000                             // min. time between two writes of the session file (ms)
+#define HTTP_SESSION_FILE_VERSION 1                                  // format version of the persisted table
+
+/**
+ * @brief Fixed-size table of web login sessions.
+ *
+ * A session is a random binary token with an expiry (unix time in us). Tokens
+ * are compared in constant time against all slots, so the response time does
+ * not reveal how much of a guessed token matched. When the table is full the
+ * least recently used session is replaced. Changes set a dirty flag, the
+ * owner decides when to persist the table with write().
+ */
+class HttpSessionTable
+{
+public:
+    /**
+     * @brief Starts a new session.
+     *
+     * @param expiry Unix time in us when the session ends.
+     * @param now Current unix time in us, expired sessions are reused first.
+     * @param cookie Receives the token as hex string, HTTP_SESSION_COOKIE_SIZE bytes.
+     */
+    void create(int64_t expiry, int64_t now, char *cookie)
+    {
+        Slot *target = &_slots[0];
+        for (Slot &slot : _slots)
+        {
+            if (slot.expiry <= now)
+            {
+                target = &slot;
+                break;
+            }
+            if (slot.lastUsed < target->lastUsed)
+            {
+                target = &slot;
+            }
+        }
+
+        esp_fill_random(target->token, sizeof(target->token));
+        target->expiry = expiry;
+        target->lastUsed = ++_useCounter;
+        _dirty = true;
+
+        toHex(target->token, cookie);
+    }
+
+    /**
+     * @brief Checks a session cookie.
+     *
+     * @param cookie Token as hex string.
+     * @param now Current unix time in us.
+     * @param expired Set to true if the session exists but has expired.
+     * @return true if the session exists and is valid.
+     */
+    bool validate(const char *cookie, int64_t now, bool &expired)
+    {
+        Slot *slot = find(cookie);
+        expired = false;
+
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        if (slot->expiry <= now)
+        {
+            expired = true;
+            return false;
+        }
+        slot->lastUsed = ++_useCounter;
+        return true;
+    }
+
+    /**
+     * @brief Ends a session.
+     *
+     * @param cookie Token as hex string.
+     * @return true if the session existed.
+     */
+    bool remove(const char *cookie)
+    {
+        Slot *slot = find(cookie);
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        memset(slot, 0, sizeof(Slot));
+        _dirty = true;
+        return true;
+    }
+
+    /**
+     * @brief Ends all sessions.
+     */
+    void clear()
+    {
+        memset(_slots, 0, sizeof(_slots));
+        _dirty = true;
+    }
+
+    /**
+     * @brief Whether the table changed since the last write() / read().
+     */
+    bool isDirty() const
+    {
+        return _dirty;
+    }
+
+    /**
+     * @brief Writes all sessions as binary blob.
+     *
+     * @param out Target, usually the opened session file.
+     */
+    void write(Print &out)
+    {
+        FileHeader header = {HTTP_SESSION_FILE_MAGIC, HTTP_SESSION_FILE_VERSION, HTTP_SESSION_SLOTS};
+        out.write((const uint8_t *)&header, sizeof(header));
+        for (const Slot &slot : _slots)
+        {
+            out.write(slot.token, sizeof(slot.token));
+            out.write((const uint8_t *)&slot.expiry, sizeof(slot.expiry));
+        }
+        _dirty = false;
+    }
+
+    /**
+     * @brief Restores sessions written by write().
+     *
+     * @param in Source, usually the opened session file.
+     * @return false if the data is missing, truncated or from another format, the table is empty then.
+     */
+    bool read(Stream &in)
+    {
+        clear();
+        _dirty = false;
+
+        FileHeader header;
+        if (in.readBytes((char *)&header, sizeof(header)) != sizeof(header) ||
+            header.magic != HTTP_SESSION_FILE_MAGIC || header.version != HTTP_SESSION_FILE_VERSION)
+        {
+            return false;
+        }
+
+        for (uint16_t i = 0; i < header.slots; i++)
+        {
+            Slot slot = {};
+            if (in.readBytes((char *)slot.token, sizeof(slot.token)) != sizeof(slot.token) ||
+                in.readBytes((char *)&slot.expiry, sizeof(slot.expiry)) != sizeof(slot.expiry))
+            {
+                clear();
+                _dirty = false;
+                return false;
+            }
+            if (i < HTTP_SESSION_SLOTS)
+            {
+                _slots[i] = slot;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        uint8_t token[HTTP_SESSION_TOKEN_SIZE]; // Random session token
+        int64_t expiry;                         // Unix time in us when the session ends, 0 = free
+        uint32_t lastUsed;                      // Use counter value of the last request, for LRU replacement
+    };
+
+    struct FileHeader
+    {
+        uint32_t magic;   // HTTP_SESSION_FILE_MAGIC
+        uint16_t version; // HTTP_SESSION_FILE_VERSION
+        uint16_t slots;   // Number of slots that follow
+    };
+
+    Slot _slots[HTTP_SESSION_SLOTS] = {}; // Session storage
+    uint32_t _useCounter = 0;             // Increased on each use of a session
+    bool _dirty = false;                  // Changed since the last write() / read()
+
+    /**
+     * @brief Finds the slot of a token, checks every slot in constant time.
+     */
+    Slot *find(const char *cookie)
+    {
+        uint8_t token[HTTP_SESSION_TOKEN_SIZE];
+        if (!fromHex(cookie, token))
+        {
+            return nullptr;
+        }
+
+        Slot *match = nullptr;
+        for (Slot &slot : _slots)
+        {
+            uint8_t diff = 0;
+            for (size_t i = 0; i < sizeof(token); i++)
+            {
+                diff |= slot.token[i] ^ token[i];
+            }
+            // a free slot never matches, its token is all zero
+            bool hit = (diff == 0) & (slot.expiry != 0);
+            match = hit ? &slot : match;
+        }
+        return match;
+    }
+
+    static void toHex(const uint8_t *token, char *out)
+    {
+        static const char digits[] = "0123456789abcdef";
+        for (size_t i = 0; i < HTTP_SESSION_TOKEN_SIZE; i++)
+        {
+            out[i * 2] = digits[token[i] >> 4];
+            out[i * 2 + 1] = digits[token[i] & 0x0F];
+        }
+        out[HTTP_SESSION_TOKEN_SIZE * 2] = '\0';
+    }
+
+    static bool fromHex(const char *in, uint8_t *token)
+    {
+        for (size_t i = 0; i < HTTP_SESSION_TOKEN_SIZE * 2; i++)
+        {
+            int nibble = hexValue(in[i]);
+            if (nibble < 0)
+            {
+                return false;
+            }
+            if (i % 2 == 0)
+            {
+                token[i / 2] = nibble << 4;
+            }
+            else
+            {
+                token[i / 2] |= nibble;
+            }
+        }
+        // the cookie value ends with the token
+        return in[HTTP_SESSION_TOKEN_SIZE * 2] == '\0' || in[HTTP_SESSION_TOKEN_SIZE * 2] == ';';
+    }
+
+    static int hexValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+};
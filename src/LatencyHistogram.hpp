@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <ArduinoJson.h>
+
+/**
+ * @brief Fixed-bucket histogram for request latencies.
+ *
+ * Samples are recorded in microseconds and sorted into buckets with upper bounds
+ * of 1, 2, 5, 10, 20, 50, 100, 200, 500 and 1000 ms plus one overflow bucket.
+ * Recording is lock-free so it can be fed from one task and read from another.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr uint8_t BUCKET_COUNT = 11;
+
+    /**
+     * @brief Records a single latency sample.
+     *
+     * @param us Latency in microseconds.
+     */
+    void add(int64_t us)
+    {
+        if (us < 0)
+        {
+            us = 0;
+        }
+
+        uint8_t bucket = 0;
+        while (bucket < BUCKET_COUNT - 1 && us > (int64_t)BUCKET_BOUNDS_MS[bucket] * 1000)
+        {
+            bucket++;
+        }
+
+        _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _sumUs.fetch_add((uint64_t)us, std::memory_order_relaxed);
+
+        uint32_t prevMax = _maxUs.load(std::memory_order_relaxed);
+        while ((uint32_t)us > prevMax && !_maxUs.compare_exchange_weak(prevMax, (uint32_t)us, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /**
+     * @brief Clears all recorded samples.
+     */
+    void reset()
+    {
+        for (uint8_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            _buckets[i].store(0, std::memory_order_relaxed);
+        }
+        _count.store(0, std::memory_order_relaxed);
+        _sumUs.store(0, std::memory_order_relaxed);
+        _maxUs.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the number of recorded samples.
+     */
+    uint32_t count() const
+    {
+        return _count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Writes count, average, maximum and bucket counts into a JSON object.
+     *
+     * Bucket keys are named after their upper bound ("le1ms" ... "le1000ms", "gt1000ms").
+     *
+     * @param json Target JSON object.
+     */
+    void toJson(JsonObject json) const
+    {
+        uint32_t count = _count.load(std::memory_order_relaxed);
+        json[F("count")] = count;
+        json[F("avgUs")] = count > 0 ? (uint32_t)(_sumUs.load(std::memory_order_relaxed) / count) : 0;
+        json[F("maxUs")] = _maxUs.load(std::memory_order_relaxed);
+
+        JsonObject buckets = json[F("buckets")].to<JsonObject>();
+        char key[12];
+        for (uint8_t i = 0; i < BUCKET_COUNT - 1; i++)
+        {
+            snprintf(key, sizeof(key), "le%ums", (unsigned int)BUCKET_BOUNDS_MS[i]);
+            buckets[key] = _buckets[i].load(std::memory_order_relaxed);
+        }
+        snprintf(key, sizeof(key), "gt%ums", (unsigned int)BUCKET_BOUNDS_MS[BUCKET_COUNT - 2]);
+        buckets[key] = _buckets[BUCKET_COUNT - 1].load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint16_t BUCKET_BOUNDS_MS[BUCKET_COUNT - 1] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+
+    std::atomic<uint32_t> _buckets[BUCKET_COUNT] = {}; // Sample count per bucket
+    std::atomic<uint32_t> _count{0};                   // Total number of samples
+    std::atomic<uint64_t> _sumUs{0};                   // Sum of all samples (us), used for the average
+    std::atomic<uint32_t> _maxUs{0};                   // Largest sample seen (us)
+};
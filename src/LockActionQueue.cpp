@@ -0,0 +1,170 @@
+#include "LockActionQueue.h"
+#include "EspMillis.h"
+
+LockActionQueue::LockActionQueue()
+{
+    _mutex = xSemaphoreCreateMutex();
+}
+
+LockActionQueue::~LockActionQueue()
+{
+    vSemaphoreDelete(_mutex);
+}
+
+uint32_t LockActionQueue::push(NukiLock::LockAction action)
+{
+    LockActionRequest *last = nullptr;
+    LockActionRequest *slot = nullptr;
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    _pushed++;
+
+    for (LockActionRequest &request : _requests)
+    {
+        if (request.state == LockActionState::Queued && (last == nullptr || request.id > last->id))
+        {
+            last = &request;
+        }
+        // reuse a free slot or the one finished first
+        if (request.state == LockActionState::Empty ||
+            ((request.state == LockActionState::Done || request.state == LockActionState::Failed) &&
+             (slot == nullptr || (slot->state != LockActionState::Empty && request.id < slot->id))))
+        {
+            slot = &request;
+        }
+    }
+
+    // the same action is still waiting, it covers this one as well
+    if (last != nullptr && last->action == action)
+    {
+        uint32_t id = last->id;
+        _coalesced++;
+        xSemaphoreGive(_mutex);
+        return id;
+    }
+
+    if (slot == nullptr)
+    {
+        _rejected++;
+        xSemaphoreGive(_mutex);
+        return 0;
+    }
+
+    *slot = LockActionRequest();
+    slot->id = _nextId++;
+    slot->action = action;
+    slot->state = LockActionState::Queued;
+    slot->enqueuedTs = espMillis();
+    uint32_t id = slot->id;
+
+    xSemaphoreGive(_mutex);
+    return id;
+}
+
+bool LockActionQueue::next(LockActionRequest &request)
+{
+    LockActionRequest *oldest = nullptr;
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    for (LockActionRequest &queued : _requests)
+    {
+        if (queued.state == LockActionState::Queued && (oldest == nullptr || queued.id < oldest->id))
+        {
+            oldest = &queued;
+        }
+    }
+
+    if (oldest != nullptr)
+    {
+        oldest->state = LockActionState::Running;
+        oldest->dispatchedTs = espMillis();
+        request = *oldest;
+    }
+    xSemaphoreGive(_mutex);
+
+    return oldest != nullptr;
+}
+
+void LockActionQueue::complete(uint32_t id, Nuki::CmdResult result)
+{
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    for (LockActionRequest &request : _requests)
+    {
+        if (request.id == id && request.state == LockActionState::Running)
+        {
+            request.result = result;
+            request.state = result == Nuki::CmdResult::Success ? LockActionState::Done : LockActionState::Failed;
+            request.completedTs = espMillis();
+            _latency.add((request.completedTs - request.enqueuedTs) * 1000);
+            if (request.state == LockActionState::Failed)
+            {
+                _failed++;
+            }
+            break;
+        }
+    }
+    xSemaphoreGive(_mutex);
+}
+
+bool LockActionQueue::find(uint32_t id, LockActionRequest &request, uint32_t waitMs)
+{
+    int64_t timeoutTs = espMillis() + waitMs;
+
+    while (true)
+    {
+        bool found = false;
+
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        for (const LockActionRequest &slot : _requests)
+        {
+            if (slot.id == id && slot.state != LockActionState::Empty)
+            {
+                request = slot;
+                found = true;
+                break;
+            }
+        }
+        xSemaphoreGive(_mutex);
+
+        if (!found)
+        {
+            return false;
+        }
+        if (request.state == LockActionState::Done || request.state == LockActionState::Failed || espMillis() >= timeoutTs)
+        {
+            return true;
+        }
+        vTaskDelay(LOCK_ACTION_WAIT_POLL_INTERVAL / portTICK_PERIOD_MS);
+    }
+}
+
+size_t LockActionQueue::pending()
+{
+    size_t count = 0;
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    for (const LockActionRequest &request : _requests)
+    {
+        if (request.state == LockActionState::Queued || request.state == LockActionState::Running)
+        {
+            count++;
+        }
+    }
+    xSemaphoreGive(_mutex);
+
+    return count;
+}
+
+void LockActionQueue::statsToJson(JsonObject json)
+{
+    size_t count = pending();
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    json[F("pending")] = count;
+    json[F("pushed")] = _pushed;
+    json[F("coalesced")] = _coalesced;
+    json[F("rejected")] = _rejected;
+    json[F("failed")] = _failed;
+    _latency.toJson(json[F("latency")].to<JsonObject>());
+    xSemaphoreGive(_mutex);
+}
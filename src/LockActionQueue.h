@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "NukiLockConstants.h"
+#include "Config.h"
+#include "LatencyHistogram.hpp"
+
+enum class LockActionState : uint8_t
+{
+    Empty,   // slot unused
+    Queued,  // waiting for the Nuki task
+    Running, // sent to the lock, retries included
+    Done,    // lock reported success
+    Failed   // lock reported an error or all retries failed
+};
+
+/**
+ * @brief A lock action requested via API and its progress.
+ */
+struct LockActionRequest
+{
+    uint32_t id = 0;                                          // Request id, increases with every new request
+    NukiLock::LockAction action = (NukiLock::LockAction)0xff; // Requested action
+    LockActionState state = LockActionState::Empty;           // Progress
+    Nuki::CmdResult result = (Nuki::CmdResult)0;              // Result of the last attempt, valid once finished
+    int64_t enqueuedTs = 0;                                   // espMillis() when queued
+    int64_t dispatchedTs = 0;                                 // espMillis() when taken by the Nuki task
+    int64_t completedTs = 0;                                  // espMillis() when finished
+};
+
+/**
+ * @brief Fixed-capacity, thread-safe queue of lock actions between network and Nuki task.
+ *
+ * The network task pushes actions and gets a request id back, the Nuki task takes
+ * them in order with next() and reports the result with complete(). Finished
+ * requests stay in their slot until it is needed again, so the result can still be
+ * looked up by id. An action equal to the last one still waiting is merged into it.
+ * If all slots wait or run, push() rejects the action instead of dropping another one.
+ */
+class LockActionQueue
+{
+public:
+    LockActionQueue();
+
+    virtual ~LockActionQueue();
+
+    /**
+     * @brief Queues a lock action.
+     *
+     * @param action Action to perform.
+     * @return Request id, 0 if the queue is full.
+     */
+    uint32_t push(NukiLock::LockAction action);
+
+    /**
+     * @brief Takes the oldest queued action and marks it as running.
+     *
+     * @param request Receives the request.
+     * @return true if an action was queued.
+     */
+    bool next(LockActionRequest &request);
+
+    /**
+     * @brief Finishes a running action.
+     *
+     * @param id Request id returned by next().
+     * @param result Result reported by the lock.
+     */
+    void complete(uint32_t id, Nuki::CmdResult result);
+
+    /**
+     * @brief Looks up a request, optionally waits until it is finished.
+     *
+     * @param id Request id.
+     * @param request Receives the request.
+     * @param waitMs Max. time to wait for Done / Failed, 0 returns the current state.
+     * @return false if the id is unknown or its slot has been reused.
+     */
+    bool find(uint32_t id, LockActionRequest &request, uint32_t waitMs = 0);
+
+    /**
+     * @brief Number of queued and running actions.
+     */
+    size_t pending();
+
+    /**
+     * @brief Writes the counters and the enqueue-to-completion latency into a JSON object.
+     */
+    void statsToJson(JsonObject json);
+
+private:
+    LockActionRequest _requests[LOCK_ACTION_QUEUE_SIZE]; // Slots, ordered by id
+    uint32_t _nextId = 1;                                // Id of the next new request
+    SemaphoreHandle_t _mutex;                            // Guards the slots
+    LatencyHistogram _latency;                           // Time from push() to complete()
+                                                         //
+    uint32_t _pushed = 0;                                // Statistics
+    uint32_t _coalesced = 0;                             //
+    uint32_t _rejected = 0;                              //
+    uint32_t _failed = 0;                                //
+};
@@ -5,5 +5,6 @@ enum class LockActionResult
     Success,
     UnknownAction,
     AccessDenied,
+    QueueFull,
     Failed
 };
\ No newline at end of file
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <Arduino.h>
+#include <time.h>
+#include "LogRingBuffer.hpp"
+
+/*
+ * Compact binary log file format
+ *
+ * The file is a plain sequence of records, each starting with a tag byte.
+ * Numbers are unsigned LEB128 varints.
+ *
+ *   Base record   0xF0 | uptime ms (absolute) | unix time s at that uptime (0 = time not synced)
+ *   Log record    level (0 = TRACE ... 5 = CRITICAL) | uptime delta ms | message length | message
+ *   Typed record  0xF1 | uptime delta ms | type length | type | message length | message
+ *
+ * A base record is written at the start of every file, after each boot and when
+ * the time gets synced, so the timestamps of the following records can be
+ * restored. Typed records carry "[XYZ]" types that are no known log level.
+ * tools/decode_binary_log.py renders a binary log file as JSON lines.
+ */
+
+#define LOG_BINARY_TAG_BASE 0xF0
+#define LOG_BINARY_TAG_TYPED 0xF1
+
+/**
+ * @brief Encodes log records into the binary log format.
+ *
+ * Keeps the uptime of the previous record to write deltas, call reset() whenever
+ * a new (empty) file is started.
+ */
+class LogBinaryWriter
+{
+public:
+    /**
+     * @brief Forget the previous record, the next write() starts with a base record.
+     */
+    void reset()
+    {
+        _baseWritten = false;
+    }
+
+    /**
+     * @brief Encodes a record.
+     *
+     * @param out Target, usually the opened log file.
+     * @param record Record to encode, uses uptime, type and message.
+     * @param synced Whether the system time is synced.
+     */
+    void write(Print &out, const LogRecord &record, bool synced)
+    {
+        int64_t uptime = record.uptime < _lastUptime && _baseWritten ? _lastUptime : record.uptime;
+
+        if (!_baseWritten || synced != _baseSynced)
+        {
+            out.write((uint8_t)LOG_BINARY_TAG_BASE);
+            writeVarint(out, (uint64_t)uptime);
+            writeVarint(out, synced ? (uint64_t)time(NULL) : 0);
+            _baseWritten = true;
+            _baseSynced = synced;
+            _lastUptime = uptime;
+        }
+
+        int level = levelFromString(record.type);
+        if (level < 0)
+        {
+            out.write((uint8_t)LOG_BINARY_TAG_TYPED);
+            writeVarint(out, (uint64_t)(uptime - _lastUptime));
+            writeString(out, record.type);
+        }
+        else
+        {
+            out.write((uint8_t)level);
+            writeVarint(out, (uint64_t)(uptime - _lastUptime));
+        }
+        writeString(out, record.message);
+        _lastUptime = uptime;
+    }
+
+private:
+    int64_t _lastUptime = 0;   // Uptime of the previous record (ms)
+    bool _baseWritten = false; // Whether the current file has a base record
+    bool _baseSynced = false;  // Whether the last base record carries a unix time
+
+    static void writeVarint(Print &out, uint64_t value)
+    {
+        uint8_t buf[10];
+        size_t len = 0;
+        do
+        {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            buf[len++] = value ? (byte | 0x80) : byte;
+        } while (value);
+        out.write(buf, len);
+    }
+
+    static void writeString(Print &out, const char *str)
+    {
+        size_t len = strlen(str);
+        writeVarint(out, len);
+        out.write((const uint8_t *)str, len);
+    }
+
+    static int levelFromString(const char *type)
+    {
+        static const char *const names[] = {"TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"};
+        for (uint8_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+        {
+            if (strcmp(type, names[i]) == 0)
+                return i;
+        }
+        return -1;
+    }
+};
+
+/**
+ * @brief Decodes a binary log file back into log records with formatted timestamps.
+ */
+class LogBinaryReader
+{
+public:
+    /**
+     * @brief Reads the next log record.
+     *
+     * @param in Source, usually the opened log file.
+     * @param record Receives the record, timestamp is formatted like in the text log.
+     * @return false at the end of the file or on a truncated / corrupt record.
+     */
+    bool next(Stream &in, LogRecord &record)
+    {
+        while (true)
+        {
+            int tag = in.read();
+            if (tag < 0)
+                return false;
+
+            uint64_t value;
+            if (tag == LOG_BINARY_TAG_BASE)
+            {
+                uint64_t epoch;
+                if (!readVarint(in, value) || !readVarint(in, epoch))
+                    return false;
+                if ((int64_t)value < _uptime)
+                {
+                    _boot++; // uptime went back, the device was restarted
+                }
+                _uptime = (int64_t)value;
+                _baseUptime = _uptime;
+                _baseEpoch = (time_t)epoch;
+                continue;
+            }
+
+            if (tag != LOG_BINARY_TAG_TYPED && tag > 5)
+                return false;
+
+            if (!readVarint(in, value))
+                return false;
+            _uptime += (int64_t)value;
+            record.uptime = _uptime;
+
+            if (tag == LOG_BINARY_TAG_TYPED)
+            {
+                if (!readString(in, record.type, sizeof(record.type)))
+                    return false;
+            }
+            else
+            {
+                static const char *const names[] = {"TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"};
+                strlcpy(record.type, names[tag], sizeof(record.type));
+            }
+
+            if (!readString(in, record.message, sizeof(record.message)))
+                return false;
+
+            formatTimestamp(record.timestamp, sizeof(record.timestamp));
+            return true;
+        }
+    }
+
+    /**
+     * @brief Number of restarts seen so far, identifies the boot of the last record.
+     */
+    uint32_t boot() const
+    {
+        return _boot;
+    }
+
+private:
+    uint32_t _boot = 0;      // Restarts seen so far
+    int64_t _uptime = 0;     // Uptime of the current record (ms)
+    int64_t _baseUptime = 0; // Uptime of the last base record (ms)
+    time_t _baseEpoch = 0;   // Unix time of the last base record, 0 if not synced
+
+    static bool readVarint(Stream &in, uint64_t &value)
+    {
+        value = 0;
+        for (uint8_t shift = 0; shift < 64; shift += 7)
+        {
+            int byte = in.read();
+            if (byte < 0)
+                return false;
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    static bool readString(Stream &in, char *buffer, size_t size)
+    {
+        uint64_t len;
+        if (!readVarint(in, len) || len > 0xFFFF)
+            return false;
+
+        size_t keep = len < size ? (size_t)len : size - 1;
+        if (in.readBytes(buffer, keep) != keep)
+            return false;
+        buffer[keep] = '\0';
+
+        // skip what doesn't fit
+        for (uint64_t i = keep; i < len; i++)
+        {
+            if (in.read() < 0)
+                return false;
+        }
+        return true;
+    }
+
+    void formatTimestamp(char *buffer, size_t size) const
+    {
+        if (_baseEpoch != 0)
+        {
+            struct tm timeinfo;
+            time_t now = _baseEpoch + (time_t)((_uptime - _baseUptime) / 1000);
+            localtime_r(&now, &timeinfo);
+
+            snprintf(buffer, size, "%04d-%02d-%02dT%02d:%02d:%02dZ",
+                     timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
+                     timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
+        }
+        else
+        {
+            int64_t millis = _uptime;
+            int days = millis / (1000LL * 60 * 60 * 24);
+            millis %= (1000LL * 60 * 60 * 24);
+            int hours = millis / (1000LL * 60 * 60);
+            millis %= (1000LL * 60 * 60);
+            int minutes = millis / (1000LL * 60);
+            millis %= (1000LL * 60);
+            int seconds = millis / 1000;
+
+            snprintf(buffer, size, "P%dDT%02dH%02dM%02dS", days, hours, minutes, seconds);
+        }
+    }
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+
+#define LOG_RING_SIZE 64       // number of log records that can be pending (power of two), covers the boot burst
+#define LOG_RING_MSG_SIZE 256  // max. message length of a single record incl. zero termination
+#define LOG_MAX_MSG_LEN (LOG_RING_MSG_SIZE - 1) // upper limit of the configurable message length
+#define LOG_RING_TIME_SIZE 25  // ISO-8601 time / uptime string incl. zero termination
+#define LOG_RING_TYPE_SIZE 12  // log level string incl. zero termination
+
+static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE must be a power of two");
+
+/**
+ * @brief A single log line waiting to be written to the log file.
+ */
+struct LogRecord
+{
+    int64_t uptime;                     // Uptime of the log call (ms)
+    char timestamp[LOG_RING_TIME_SIZE]; // Time (if synced) or uptime of the log call, empty in binary mode
+    char type[LOG_RING_TYPE_SIZE];      // Log level as string
+    char message[LOG_RING_MSG_SIZE];    // Message without level prefix
+};
+
+/**
+ * @brief Bounded lock-free multi-producer ring buffer of log records.
+ *
+ * Any task may push concurrently, records are popped by the log writer task.
+ * Each slot carries a sequence number that tells producers and the consumer
+ * whether the slot is free or holds a record of the current round, so no
+ * mutex is needed. push() never blocks and fails if the buffer is full.
+ */
+class LogRingBuffer
+{
+public:
+    LogRingBuffer()
+    {
+        for (uint32_t i = 0; i < LOG_RING_SIZE; i++)
+        {
+            _slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Adds a record.
+     *
+     * @param record Record to copy into the buffer.
+     * @return false if the buffer is full.
+     */
+    bool push(const LogRecord &record)
+    {
+        uint32_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+
+        while (true)
+        {
+            slot = &_slots[pos & MASK];
+            uint32_t seq = slot->seq.load(std::memory_order_acquire);
+            int32_t diff = (int32_t)seq - (int32_t)pos;
+
+            if (diff == 0)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        memcpy(&slot->record, &record, sizeof(LogRecord));
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest record.
+     *
+     * @param record Receives the record.
+     * @return false if the buffer is empty.
+     */
+    bool pop(LogRecord &record)
+    {
+        uint32_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+
+        while (true)
+        {
+            slot = &_slots[pos & MASK];
+            uint32_t seq = slot->seq.load(std::memory_order_acquire);
+            int32_t diff = (int32_t)seq - (int32_t)(pos + 1);
+
+            if (diff == 0)
+            {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // empty
+            }
+            else
+            {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        memcpy(&record, &slot->record, sizeof(LogRecord));
+        slot->seq.store(pos + MASK + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Returns the (approximate) number of pending records.
+     */
+    uint32_t size() const
+    {
+        return _enqueuePos.load(std::memory_order_relaxed) - _dequeuePos.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32_t MASK = LOG_RING_SIZE - 1;
+
+    struct Slot
+    {
+        std::atomic<uint32_t> seq; // Sequence number, tells whether the slot is free or filled
+        LogRecord record;          // Stored record
+    };
+
+    Slot _slots[LOG_RING_SIZE];           // Record storage
+    std::atomic<uint32_t> _enqueuePos{0}; // Next position to write
+    std::atomic<uint32_t> _dequeuePos{0}; // Next position to read
+};
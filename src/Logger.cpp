@@ -1,5 +1,8 @@
 #include "Logger.h"
 
+// Level names, indexed by Logger::msgtype
+static const char *const levelNames[] = {"TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"};
+
 #ifdef DEBUG_NUKIBRIDGE
 
 Logger::Logger(Print *serial, Preferences *prefs)
@@ -53,11 +56,35 @@ void Logger::disableFileLog(){
   _serial->println(F("writiing to Log file disabled!"));
 }
 
+void Logger::flush() {}
+
+void Logger::log(msgtype level, const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  _serial->printf("[%s] ", levelNames[level]);
+  _serial->vprintf(format, args);
+  _serial->println();
+  va_end(args);
+}
+
+void Logger::log(msgtype level, const __FlashStringHelper *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  _serial->printf("[%s] ", levelNames[level]);
+  _serial->vprintf(reinterpret_cast<const char *>(format), args);
+  _serial->println();
+  va_end(args);
+}
+
 #else // LittleFS based logging
 
 Logger::Logger(Print *serial, Preferences *prefs)
     : _serial(serial), _preferences(prefs)
 {
+  _fileMutex = xSemaphoreCreateRecursiveMutex();
+  _sharedLineMutex = xSemaphoreCreateMutex();
 
   if (!_preferences)
   {
@@ -72,90 +99,248 @@ Logger::Logger(Print *serial, Preferences *prefs)
   {
     _backupEnabled = _preferences->getBool(preference_log_backup_enabled, false);
     _logFile = LOGGER_FILENAME;
-    _maxMsgLen = _preferences->getInt(preference_log_max_msg_len, 128);
+    // records have a fixed size, longer messages could not be stored anyway
+    _maxMsgLen = constrain(_preferences->getInt(preference_log_max_msg_len, 128), 1, LOG_MAX_MSG_LEN);
     _maxLogFileSize = _preferences->getInt(preference_log_max_file_size, 256); // in kb
     _currentLogLevel = (msgtype)_preferences->getInt(preference_log_level, 2);
+    _binaryFormat = _preferences->getBool(preference_log_binary, false);
+  }
+  _rotatedFile = LOGGER_ROTATED_FILENAME;
+  if (_binaryFormat)
+  {
+    _logFile = LOGGER_BINARY_FILENAME;
+    _rotatedFile = LOGGER_BINARY_ROTATED_FILENAME;
   }
   _fileWriteEnabled = true;
-  _buffer.reserve(_maxMsgLen + 2); // Reserves memory for up to _maxMsgLen characters
+
+  if (xTaskCreatePinnedToCore(backupTask, "logBackup", LOGGER_BACKUP_TASK_SIZE, this, 1, &_backupTaskHandle, tskNO_AFFINITY) != pdPASS)
+  {
+    _backupTaskHandle = nullptr;
+    _serial->println(F("[ERROR] Log backup task could not be started"));
+  }
+  if (xTaskCreatePinnedToCore(writerTask, "logWriter", LOGGER_TASK_SIZE, this, 1, &_writerTaskHandle, tskNO_AFFINITY) != pdPASS)
+  {
+    _writerTaskHandle = nullptr;
+    _serial->println(F("[ERROR] Log writer task could not be started, writing log file synchronously"));
+  }
 }
 
-Logger::~Logger() {}
+Logger::~Logger()
+{
+  if (_backupTaskHandle)
+  {
+    vTaskDelete(_backupTaskHandle);
+    _backupTaskHandle = nullptr;
+  }
+  if (_writerTaskHandle)
+  {
+    vTaskDelete(_writerTaskHandle);
+    _writerTaskHandle = nullptr;
+  }
+  flush();
+  vSemaphoreDelete(_fileMutex);
+  vSemaphoreDelete(_sharedLineMutex);
+}
 
-size_t Logger::write(uint8_t c)
+void Logger::writerTask(void *parameter)
 {
-  if (!_fileWriteEnabled || _logBackupIsRunning.load() || _logFallBack.load())
-    return _serial->write(c);
+  Logger *logger = static_cast<Logger *>(parameter);
 
-  _buffer += (char)c;
-  if (c == '\n')
+  while (true)
   {
-    _buffer.trim();
-    if (!_buffer.isEmpty())
-      toFile(_buffer);
-    _buffer = "";
+    // wake up early if the queue fills up, otherwise collect lines for one interval
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOGGER_FLUSH_INTERVAL));
+    logger->writeQueue();
   }
-  return 1;
+}
+
+void Logger::backupTask(void *parameter)
+{
+  Logger *logger = static_cast<Logger *>(parameter);
+  uint32_t retryDelay = 0; // 0 = nothing to retry, wait for the next rotation
+
+  while (true)
+  {
+    // a new rotation wakes the task up early, also while waiting for a retry
+    ulTaskNotifyTake(pdTRUE, retryDelay == 0 ? portMAX_DELAY : pdMS_TO_TICKS(retryDelay));
+
+    if (!logger->_backupEnabled)
+    {
+      retryDelay = 0;
+      continue;
+    }
+
+    if (logger->backupFileToFTPServer())
+    {
+      retryDelay = 0;
+    }
+    else
+    {
+      retryDelay = retryDelay == 0 ? LOGGER_BACKUP_RETRY_MIN : std::min<uint32_t>(retryDelay * 2, LOGGER_BACKUP_RETRY_MAX);
+      logger->printf("[WARNING] FTP backup failed, retrying in %u s\n", (unsigned int)(retryDelay / 1000));
+    }
+  }
+}
+
+void Logger::flush()
+{
+  writeQueue();
+}
+
+void Logger::rotate()
+{
+  if (!_backupEnabled || _backupTaskHandle == nullptr)
+  {
+    clear();
+    return;
+  }
+
+  if (_logBackupIsRunning.load())
+  {
+    // the rotated file is being uploaded, don't replace it
+    println(F("[WARNING] Log file too large while FTP backup is running, clearing log file"));
+    clear();
+    return;
+  }
+
+  if (LittleFS.exists(String("/") + _rotatedFile))
+  {
+    println(F("[WARNING] Previous log file was not backed up yet and is overwritten"));
+    LittleFS.remove(String("/") + _rotatedFile);
+  }
+
+  if (!LittleFS.rename(String("/") + _logFile, String("/") + _rotatedFile))
+  {
+    println(F("[ERROR] Failed to rotate log file, clearing log file"));
+    clear();
+    return;
+  }
+  _binaryWriter.reset();
+
+  xTaskNotifyGive(_backupTaskHandle);
+}
+
+size_t Logger::write(uint8_t c)
+{
+  return write(&c, 1);
 }
 
 size_t Logger::write(const uint8_t *buffer, size_t size)
 {
-  if (!_fileWriteEnabled || _logBackupIsRunning.load() || _logFallBack.load())
+  if (!_fileWriteEnabled || _logFallBack.load())
     return _serial->write(buffer, size);
 
-  if (size == 2 && buffer[0] == '\r' && buffer[1] == '\n')
+  LineBuffer *line = taskLineBuffer();
+  if (line)
+  {
+    appendToLine(*line, (const char *)buffer, size);
+    // line complete, let other tasks use the buffer
+    if (line->len == 0 && !line->suppress)
+      line->owner.store(nullptr);
+  }
+  else
+  {
+    // all line buffers are taken, share the last one
+    xSemaphoreTake(_sharedLineMutex, portMAX_DELAY);
+    appendToLine(_lineBuffers[LOGGER_LINE_BUFFERS - 1], (const char *)buffer, size);
+    xSemaphoreGive(_sharedLineMutex);
+  }
+  return size;
+}
+
+Logger::LineBuffer *Logger::taskLineBuffer(bool claim)
+{
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+  for (uint8_t i = 0; i < LOGGER_LINE_BUFFERS - 1; i++)
   {
-    _buffer.trim();
-    if (!_buffer.isEmpty())
-      toFile(_buffer);
-    _buffer = "";
-    return 2;
+    if (_lineBuffers[i].owner.load() == task)
+      return &_lineBuffers[i];
   }
-  else if (size > 0 && size <= _maxMsgLen && buffer[size - 1] == '\n')
+
+  if (!claim)
+    return nullptr;
+
+  for (uint8_t i = 0; i < LOGGER_LINE_BUFFERS - 1; i++)
   {
-    _buffer = String((const char *)buffer);
-    _buffer.trim();
-    if (!_buffer.isEmpty())
-      toFile(_buffer);
-    _buffer = "";
-    return 1;
+    TaskHandle_t expected = nullptr;
+    if (_lineBuffers[i].owner.compare_exchange_strong(expected, task))
+      return &_lineBuffers[i];
   }
-  else
+  return nullptr;
+}
+
+void Logger::appendToLine(LineBuffer &line, const char *data, size_t size)
+{
+  while (size > 0)
   {
-    size_t n = 0;
-    while (size--)
-      n += write(*buffer++);
-    return n;
+    const char *newline = (const char *)memchr(data, '\n', size);
+    size_t chunk = newline ? newline - data : size;
+
+    // Discard lines whose level is filtered out as early as possible
+    if (line.len == 0 && !line.suppress && isSuppressed(data, chunk))
+      line.suppress = true;
+
+    if (!line.suppress)
+    {
+      if (line.len == 0 && newline)
+      {
+        // complete line in one piece, log it without copying
+        toFile(data, chunk);
+      }
+      else
+      {
+        size_t n = std::min(chunk, sizeof(line.data) - line.len);
+        memcpy(line.data + line.len, data, n);
+        line.len += n;
+        if (newline)
+          toFile(line.data, line.len);
+      }
+    }
+
+    if (newline)
+    {
+      line.len = 0;
+      line.suppress = false;
+      chunk++;
+    }
+    data += chunk;
+    size -= chunk;
   }
 }
 
 size_t Logger::printf(const __FlashStringHelper *ifsh, ...)
 {
-  char buf[_maxMsgLen + 1]; // max Msg len + zero termination
   va_list arg;
   va_start(arg, ifsh);
-  const char *format = (reinterpret_cast<const char *>(ifsh));
-  size_t len = vsnprintf(buf, sizeof(buf), format, arg);
+  size_t len = formatLine(reinterpret_cast<const char *>(ifsh), arg);
   va_end(arg);
-  if (len > 0)
-  {
-    write((const uint8_t *)buf, len);
-  }
   return len;
 }
 
 size_t Logger::printf(const char *format, ...)
 {
-  char buf[_maxMsgLen + 1]; // max Msg len + zero termination
   va_list args;
   va_start(args, format);
-  int len = vsnprintf(buf, sizeof(buf), format, args);
+  size_t len = formatLine(format, args);
   va_end(args);
-  if (len > 0)
-  {
-    write((const uint8_t *)buf, (size_t)len);
-  }
-  return (size_t)(len > 0 ? len : 0);
+  return len;
+}
+
+size_t Logger::formatLine(const char *format, va_list args)
+{
+  // don't format lines that are filtered out anyway
+  LineBuffer *line = taskLineBuffer(false);
+  if ((line == nullptr || line->len == 0) && isSuppressed(format, strnlen(format, 12)))
+    return 0;
+
+  char buf[LOG_RING_MSG_SIZE]; // max. record message length + zero termination
+  int len = vsnprintf(buf, std::min<size_t>(sizeof(buf), _maxMsgLen + 1), format, args);
+  if (len <= 0)
+    return 0;
+
+  // vsnprintf returns the untruncated length
+  return write((const uint8_t *)buf, strlen(buf));
 }
 
 size_t Logger::print(const __FlashStringHelper *ifsh)
@@ -387,8 +572,10 @@ size_t Logger::println(void)
 
 void Logger::clear()
 {
+  xSemaphoreTakeRecursive(_fileMutex, portMAX_DELAY);
   if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
   {
+    xSemaphoreGiveRecursive(_fileMutex);
     _logFallBack.store(true);
     println(F("[ERROR] LittleFS not initialized!"));
     return;
@@ -403,6 +590,8 @@ void Logger::clear()
   {
     f.close();
   }
+  _binaryWriter.reset();
+  xSemaphoreGiveRecursive(_fileMutex);
 }
 
 void Logger::resetFallBack()
@@ -463,6 +652,69 @@ void Logger::disableBackup()
   _backupEnabled = false;
 }
 
+Logger::msgtype Logger::parseLevelPrefix(const char *text, size_t len)
+{
+  if (len < 3 || text[0] != '[')
+    return (msgtype)-1;
+
+  for (uint8_t i = 0; i < sizeof(levelNames) / sizeof(levelNames[0]); i++)
+  {
+    size_t nameLen = strlen(levelNames[i]);
+    if (len > nameLen + 1 && text[nameLen + 1] == ']' && strncmp(text + 1, levelNames[i], nameLen) == 0)
+      return (msgtype)i;
+  }
+  return (msgtype)-1;
+}
+
+bool Logger::isSuppressed(const char *text, size_t len) const
+{
+  msgtype level = parseLevelPrefix(text, len);
+  return level != (msgtype)-1 && !isEnabled(level);
+}
+
+void Logger::log(msgtype level, const char *format, ...)
+{
+  if (!isEnabled(level))
+    return;
+
+  va_list args;
+  va_start(args, format);
+  logV(level, format, args);
+  va_end(args);
+}
+
+void Logger::log(msgtype level, const __FlashStringHelper *format, ...)
+{
+  if (!isEnabled(level))
+    return;
+
+  va_list args;
+  va_start(args, format);
+  logV(level, reinterpret_cast<const char *>(format), args);
+  va_end(args);
+}
+
+void Logger::logV(msgtype level, const char *format, va_list args)
+{
+  char buf[LOG_RING_MSG_SIZE];
+  size_t bufSize = std::min<size_t>(sizeof(buf), _maxMsgLen + 1);
+  if (vsnprintf(buf, bufSize, format, args) < 0)
+    return;
+
+  // strip trailing line breaks
+  size_t len = strlen(buf);
+  while (len > 0 && (buf[len - 1] == '\n' || buf[len - 1] == '\r'))
+    buf[--len] = '\0';
+
+  if (!_fileWriteEnabled || _logFallBack.load())
+  {
+    _serial->printf("[%s] %s\n", levelNames[level], buf);
+    return;
+  }
+
+  queueLine(levelNames[level], strlen(levelNames[level]), buf, len);
+}
+
 void Logger::formatUptime(char *buffer, size_t size)
 {
   if (timeSynced)
@@ -499,31 +751,40 @@ bool Logger::isFileTooBig()
 
 size_t Logger::getFileSize()
 {
+  xSemaphoreTakeRecursive(_fileMutex, portMAX_DELAY);
   if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
   {
+    xSemaphoreGiveRecursive(_fileMutex);
     _logFallBack.store(true);
     println(F("[ERROR] LittleFS not initialized!"));
     return 0;
   }
 
-  File f = LittleFS.open(_logFile, FILE_READ);
+  File f = LittleFS.open(String("/") + _logFile, FILE_READ);
   if (!f)
   {
+    xSemaphoreGiveRecursive(_fileMutex);
     return 0;
   }
-  size_t size = f.size() * 1024;
+  size_t size = f.size() / 1024;
   f.close();
+  xSemaphoreGiveRecursive(_fileMutex);
   return size;
 }
 
 bool Logger::backupFileToFTPServer()
 {
+  // Claim the rotated file under the file mutex, so rotate() doesn't replace it during the upload
+  xSemaphoreTakeRecursive(_fileMutex, portMAX_DELAY);
   bool expected = false;
   if (!_logBackupIsRunning.compare_exchange_strong(expected, true))
   {
+    xSemaphoreGiveRecursive(_fileMutex);
     println(F("[INFO] FTP Backup is running"));
     return true;
   }
+  xSemaphoreGiveRecursive(_fileMutex);
+
   if (_backupEnabled)
   {
 
@@ -531,24 +792,35 @@ bool Logger::backupFileToFTPServer()
     {
       println(F("[ERROR] Preferences not initialized!"));
       _logBackupIsRunning.store(false);
+      return false;
+    }
+
+    if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
+    {
       _logFallBack.store(true);
+      println(F("[ERROR] LittleFS not initialized!"));
+      _logBackupIsRunning.store(false);
       return false;
     }
 
+    if (!LittleFS.exists(String("/") + _rotatedFile))
+    {
+      // nothing to upload
+      _logBackupIsRunning.store(false);
+      return true;
+    }
+
     String ftpServer = _preferences->getString(preference_log_backup_ftp_server, "");
     String ftpUser = _preferences->getString(preference_log_backup_ftp_user, "");
     String ftpPass = _preferences->getString(preference_log_backup_ftp_pwd, "");
     String ftpDir = "/" + _preferences->getString(preference_log_backup_ftp_dir, "");
-    int backupIndex = _preferences->getInt(preference_log_backup_file_index, 0) + 1;
-    if (backupIndex > 100)
-      backupIndex = 1;
-    _preferences->putInt(preference_log_backup_file_index, backupIndex);
 
     if (ftpServer.isEmpty() || ftpUser.isEmpty() || ftpPass.isEmpty())
     {
-      _serial->println(F("[WARNING] Backup disabled or no FTP Server set."));
-      clear();
-      return false;
+      println(F("[WARNING] Backup disabled or no FTP Server set."));
+      LittleFS.remove(String("/") + _rotatedFile);
+      _logBackupIsRunning.store(false);
+      return true; // retrying won't help
     }
 
     println(F("[INFO] Backing up log file to FTP Server..."));
@@ -567,10 +839,27 @@ bool Logger::backupFileToFTPServer()
     if (!ftp.isConnected())
     {
       println(F("[ERROR] FTP connection failed!"));
+      _backupFailures++;
       _logBackupIsRunning.store(false);
-      _logFallBack.store(true);
       return false;
     }
+
+    File f = LittleFS.open(String("/") + _rotatedFile, FILE_READ);
+    if (!f)
+    {
+      println(F("[ERROR] Failed to open log file for backup!"));
+      ftp.CloseConnection();
+      _backupFailures++;
+      _logBackupIsRunning.store(false);
+      return false;
+    }
+
+    // only advance the index for an actual upload, a retry reuses it
+    int backupIndex = _preferences->getInt(preference_log_backup_file_index, 0) + 1;
+    if (backupIndex > 100)
+      backupIndex = 1;
+    _preferences->putInt(preference_log_backup_file_index, backupIndex);
+
     ftp.InitFile("Type A");
     ftp.ChangeWorkDir(ftpDir.c_str());
 
@@ -587,24 +876,6 @@ bool Logger::backupFileToFTPServer()
     ftp.DeleteFile(backupFilename.c_str());
     ftp.NewFile(backupFilename.c_str());
 
-    if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
-    {
-      _logFallBack.store(true);
-      println(F("[ERROR] LittleFS not initialized!"));
-      _logBackupIsRunning.store(false);
-      return false;
-    }
-
-    File f = LittleFS.open(String("/") + _logFile, FILE_READ);
-    if (!f)
-    {
-      _logFallBack.store(true);
-      println(F("[ERROR] Failed to open log file for backup!"));
-      ftp.CloseConnection();
-      _logBackupIsRunning.store(false);
-      return false;
-    }
-
     const size_t bufferSize = 512; // Blocksize 512 Byte
     unsigned char buffer[bufferSize];
 
@@ -619,12 +890,27 @@ bool Logger::backupFileToFTPServer()
 
     f.close();
     ftp.CloseFile();
+    bool uploaded = ftp.isConnected(); // the client drops the connection on a failed transfer
     ftp.CloseConnection();
 
+    if (!uploaded)
+    {
+      println(F("[ERROR] FTP upload failed!"));
+      _backupFailures++;
+      _logBackupIsRunning.store(false);
+      return false;
+    }
+
+    xSemaphoreTakeRecursive(_fileMutex, portMAX_DELAY);
+    LittleFS.remove(String("/") + _rotatedFile);
+    xSemaphoreGiveRecursive(_fileMutex);
+
     println("[INFO] FTP Backup successful!");
+    _backupCount++;
     _logBackupIsRunning.store(false);
     return true;
   }
+  _logBackupIsRunning.store(false);
   return false;
 }
 
@@ -632,84 +918,588 @@ void Logger::disableFileLog(){
   _fileWriteEnabled = false;
 }
 
-void Logger::toFile(String message)
+void Logger::toFile(const char *message, size_t len)
 {
-  String msgType = levelToString(_currentLogLevel); // Default value
-
-  // Trim message if it exceeds max length
-  if (message.length() > _maxMsgLen)
+  // Trim whitespace (e.g. the \r of \r\n)
+  while (len > 0 && isspace((unsigned char)message[0]))
   {
-    message = message.substring(0, _maxMsgLen);
+    message++;
+    len--;
   }
+  while (len > 0 && isspace((unsigned char)message[len - 1]))
+    len--;
+
+  if (len == 0)
+    return;
+
+  // Trim message if it exceeds max length
+  if (len > (size_t)_maxMsgLen)
+    len = _maxMsgLen;
+
+  const char *msgType = levelNames[_currentLogLevel]; // Default value
+  size_t typeLen = strlen(msgType);
+  msgtype level = _currentLogLevel;
 
   // Check whether the message begins with [XYZ] and extract the type
-  if (message.startsWith("["))
+  if (message[0] == '[')
   {
-    int endBracket = message.indexOf("]");
-    if (endBracket > 1)
+    const char *endBracket = (const char *)memchr(message, ']', len);
+    if (endBracket && endBracket - message > 1)
     { // At least 1 character between [ and ]
-      msgType = message.substring(1, endBracket);
-      message = message.substring(endBracket + 1); // Extract the rest of the message
-      message.trim();
+      level = parseLevelPrefix(message, len);
+      msgType = message + 1;
+      typeLen = endBracket - msgType;
+
+      // Extract the rest of the message
+      len -= endBracket + 1 - message;
+      message = endBracket + 1;
+      while (len > 0 && isspace((unsigned char)message[0]))
+      {
+        message++;
+        len--;
+      }
     }
   }
 
-  // Convert msgtype from string
-  msgtype level = stringToLevel(msgType);
-
-  // Check whether this log level is within the set level
-  if (_currentLogLevel > level && (_currentLogLevel != (int)MSG_DEBUG && level == -1))
+  // Check whether this log level is within the set level, unknown types are only logged in debug / trace mode
+  if (level == (msgtype)-1 ? _currentLogLevel > MSG_DEBUG : level < _currentLogLevel)
   {
     return; // Do not log message if it is not relevant
   }
 
+  queueLine(msgType, typeLen, message, len);
+}
+
+void Logger::queueLine(const char *type, size_t typeLen, const char *message, size_t len)
+{
   // additional output on the serial interface in debug or trace mode
   if (_currentLogLevel == MSG_TRACE || _currentLogLevel == MSG_DEBUG)
-    Serial.println(message);
+  {
+    Serial.write((const uint8_t *)message, len);
+    Serial.println();
+  }
 
-  // Check file size, clear if too big
-  if (isFileTooBig())
+  // Queue the line, the writer task appends it to the log file
+  LogRecord record;
+  record.uptime = espMillis();
+  if (_binaryFormat)
+    record.timestamp[0] = '\0'; // restored from the uptime when decoding
+  else
+    formatUptime(record.timestamp, sizeof(record.timestamp));
+
+  typeLen = std::min(typeLen, sizeof(record.type) - 1);
+  memcpy(record.type, type, typeLen);
+  record.type[typeLen] = '\0';
+
+  len = std::min(len, sizeof(record.message) - 1);
+  memcpy(record.message, message, len);
+  record.message[len] = '\0';
+
+  if (!_queue.push(record))
   {
-    println(F("[INFO] Log file too large, attempt to backup to ftp Server..."));
-    if (backupFileToFTPServer())
+    // Queue full (e.g. boot burst while the writer task has not run yet): write the
+    // pending lines synchronously like before the queue existed, drop only if that
+    // isn't possible because this task is writing already.
+    if (xSemaphoreGetMutexHolder(_fileMutex) == xTaskGetCurrentTaskHandle())
     {
-      _serial->println(F("[INFO] Backup successful, clearing log file..."));
-      clear();
+      _droppedLines++;
+      return;
     }
-    else
+    writeQueue();
+    if (!_queue.push(record))
     {
-      println(F("[WARNING] Backup failed!"));
+      _droppedLines++;
+      return;
     }
   }
 
-  // Create JSON log entry
-  JsonDocument doc;
-  char timeStr[25];
-  formatUptime(timeStr, sizeof(timeStr));
-  doc[F("timestamp")] = timeStr;
-  doc[F("Type")] = msgType;
-  doc[F("message")] = message;
+  uint32_t queued = _queue.size();
+  uint32_t highWater = _queueHighWater.load();
+  while (queued > highWater && !_queueHighWater.compare_exchange_weak(highWater, queued))
+  {
+  }
 
-  String line;
-  serializeJson(doc, line);
+  if (_writerTaskHandle == nullptr)
+  {
+    // no writer task, write synchronously unless we are already writing (e.g. error message of writeQueue())
+    if (xSemaphoreGetMutexHolder(_fileMutex) != xTaskGetCurrentTaskHandle())
+      writeQueue();
+  }
+  else if (queued >= LOG_RING_SIZE / 2)
+  {
+    xTaskNotifyGive(_writerTaskHandle);
+  }
+}
+
+void Logger::writeQueue()
+{
+  if (_queue.size() == 0 && _droppedLines.load() == _reportedDrops.load())
+  {
+    return;
+  }
+
+  xSemaphoreTakeRecursive(_fileMutex, portMAX_DELAY);
+
+  // Check file size, rotate if too big
+  if (isFileTooBig())
+  {
+    rotate();
+  }
 
   if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
   {
+    xSemaphoreGiveRecursive(_fileMutex);
     _logFallBack.store(true);
     println(F("[ERROR] LittleFS not initialized!"));
     return;
   }
 
-  // Append to log file
+  // Append all queued lines with a single open
   File f = LittleFS.open(String("/") + _logFile, FILE_APPEND);
   if (!f)
   {
+    xSemaphoreGiveRecursive(_fileMutex);
     _logFallBack.store(true);
     println(F("[ERROR] Failed to open log file for appending"));
     return;
   }
-  f.println(line);
+
+  LogRecord record;
+
+  uint32_t dropped = _droppedLines.load();
+  uint32_t reported = _reportedDrops.exchange(dropped);
+  if (dropped != reported)
+  {
+    record.uptime = espMillis();
+    formatUptime(record.timestamp, sizeof(record.timestamp));
+    strlcpy(record.type, "WARNING", sizeof(record.type));
+    snprintf(record.message, sizeof(record.message), "%u log lines dropped, log queue full", (unsigned int)(dropped - reported));
+    writeRecord(f, record);
+  }
+
+  while (_queue.pop(record))
+  {
+    writeRecord(f, record);
+    _writtenLines++;
+  }
+
+  f.close();
+  xSemaphoreGiveRecursive(_fileMutex);
+}
+
+void Logger::writeRecord(File &f, const LogRecord &record)
+{
+  if (_binaryFormat)
+  {
+    _binaryWriter.write(f, record, timeSynced);
+    return;
+  }
+
+  printJsonLine(f, record);
+}
+
+void Logger::printJsonLine(Print &out, const LogRecord &record)
+{
+  // JSON log entry, same output as serializeJson() without building a document
+  out.print(F("{\"timestamp\":"));
+  printJsonString(out, record.timestamp);
+  out.print(F(",\"Type\":"));
+  printJsonString(out, record.type);
+  out.print(F(",\"message\":"));
+  printJsonString(out, record.message);
+  out.println('}');
+}
+
+void Logger::printJsonString(Print &out, const char *str)
+{
+  out.write('"');
+  const char *span = str; // start of characters that need no escaping
+  for (; *str; str++)
+  {
+    unsigned char c = *str;
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+
+    out.write((const uint8_t *)span, str - span);
+    span = str + 1;
+    switch (c)
+    {
+    case '"':
+      out.print(F("\\\""));
+      break;
+    case '\\':
+      out.print(F("\\\\"));
+      break;
+    case '\b':
+      out.print(F("\\b"));
+      break;
+    case '\f':
+      out.print(F("\\f"));
+      break;
+    case '\n':
+      out.print(F("\\n"));
+      break;
+    case '\r':
+      out.print(F("\\r"));
+      break;
+    case '\t':
+      out.print(F("\\t"));
+      break;
+    default:
+      out.printf("\\u%04x", c);
+      break;
+    }
+  }
+  out.write((const uint8_t *)span, str - span);
+  out.write('"');
+}
+
+bool Logger::query(const LogQuery &query, Print &out)
+{
+  // Write pending lines and remember the current end of the file. Lines appended
+  // while the response is streamed are not part of the result.
+  flush();
+
+  xSemaphoreTakeRecursive(_fileMutex, portMAX_DELAY);
+  if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
+  {
+    xSemaphoreGiveRecursive(_fileMutex);
+    return false;
+  }
+  File f = LittleFS.open(String("/") + _logFile, FILE_READ);
+  xSemaphoreGiveRecursive(_fileMutex);
+
+  if (!f || f.isDirectory())
+  {
+    return false;
+  }
+
+  size_t fileSize = f.size();
+  if (_binaryFormat)
+    queryBinary(query, f, fileSize, out);
+  else
+    queryText(query, f, fileSize, out);
+
   f.close();
+  return true;
+}
+
+void Logger::queryText(const LogQuery &query, File &f, size_t fileSize, Print &out)
+{
+  char chunk[LOG_QUERY_CHUNK_SIZE];
+  char line[LOG_QUERY_LINE_SIZE];
+  size_t start = 0;                // offset of the first line to return
+  size_t lineEnd = fileSize;       // end of the line in front of the scanned data (offset of its '\n')
+  size_t pos = fileSize;           // start of the scanned data
+  int64_t newerUptime = INT64_MAX; // uptime of the last line scanned that has one
+  uint32_t matches = 0;
+  size_t bytes = 0;
+  bool found = false;
+  bool truncated = false;
+
+  // Scan backwards in chunks for the start of the selected range
+  while (pos > 0 && !found)
+  {
+    size_t chunkLen = std::min<size_t>(pos, sizeof(chunk));
+    pos -= chunkLen;
+    f.seek(pos);
+    if (f.read((uint8_t *)chunk, chunkLen) != chunkLen)
+      break;
+
+    for (size_t i = chunkLen; i > 0 && !found; i--)
+    {
+      bool fileStart = pos == 0 && i == 1;
+      if (chunk[i - 1] != '\n' && !fileStart)
+        continue;
+
+      size_t lineStart = chunk[i - 1] == '\n' ? pos + i : 0;
+      size_t nextLine = std::min(lineEnd + 1, fileSize);
+      size_t len = std::min<size_t>(lineEnd - lineStart, sizeof(line) - 1);
+      lineEnd = pos + i - 1;
+      if (len == 0)
+        continue;
+
+      f.seek(lineStart);
+      len = f.read((uint8_t *)line, len);
+      line[len] = '\0';
+      if (len > 0 && line[len - 1] == '\r')
+        line[--len] = '\0';
+
+      bool older = false;
+      int64_t uptime = LOG_UPTIME_UNKNOWN;
+      bool match = queryMatchesLine(query, line, uptime, older);
+      if (uptime != LOG_UPTIME_UNKNOWN)
+      {
+        // the uptime went backwards here, this line and all in front of it are from a previous boot
+        if (uptime > newerUptime)
+        {
+          match = false;
+          older = true;
+        }
+        newerUptime = uptime;
+      }
+      if (!match)
+      {
+        if (older)
+        {
+          start = nextLine; // everything in front of this line is older
+          found = true;
+        }
+        continue;
+      }
+
+      if (bytes + len + 1 > query.maxBytes)
+      {
+        start = nextLine;
+        found = true;
+        truncated = true;
+        continue;
+      }
+
+      bytes += len + 1;
+      matches++;
+      start = lineStart;
+      if (query.tail > 0 && matches >= query.tail)
+        found = true;
+    }
+  }
+
+  // Stream the selected range
+  f.seek(start);
+  bytes = 0;
+  matches = 0;
+  while (f.position() < fileSize)
+  {
+    size_t len = f.readBytesUntil('\n', line, sizeof(line) - 1);
+    line[len] = '\0';
+    if (len > 0 && line[len - 1] == '\r')
+      line[--len] = '\0';
+
+    bool older = false;
+    int64_t uptime = LOG_UPTIME_UNKNOWN;
+    if (len == 0 || !queryMatchesLine(query, line, uptime, older))
+      continue;
+
+    if ((query.tail > 0 && matches >= query.tail) || bytes + len + 1 > query.maxBytes)
+      break;
+
+    out.write((const uint8_t *)line, len);
+    out.write('\n');
+    bytes += len + 1;
+    matches++;
+  }
+
+  if (truncated)
+    out.println(F("{\"truncated\":true}"));
+}
+
+void Logger::queryBinary(const LogQuery &query, File &f, size_t fileSize, Print &out)
+{
+  LogRecord record;
+  uint32_t total = 0;
+  uint32_t lastBoot = 0;
+
+  // First pass: count the matching records, the since filter only matches records of the current boot
+  {
+    LogBinaryReader reader;
+    while (f.position() < fileSize && reader.next(f, record))
+    {
+      if (reader.boot() != lastBoot)
+      {
+        lastBoot = reader.boot();
+        if (query.sinceMs >= 0)
+          total = 0;
+      }
+      if (queryMatches(query, record.type, strlen(record.type), record.message, record.uptime))
+        total++;
+    }
+  }
+
+  // Second pass: skip all but the last query.tail matches
+  uint32_t skip = query.tail > 0 && total > query.tail ? total - query.tail : 0;
+  size_t bytes = 0;
+  LogBinaryReader reader;
+  f.seek(0);
+  while (f.position() < fileSize && reader.next(f, record))
+  {
+    int64_t uptime = reader.boot() == lastBoot ? record.uptime : -1;
+    if (query.sinceMs >= 0 && uptime < query.sinceMs)
+      continue;
+    if (!queryMatches(query, record.type, strlen(record.type), record.message, uptime))
+      continue;
+    if (skip > 0)
+    {
+      skip--;
+      continue;
+    }
+
+    size_t lineBytes = strlen(record.timestamp) + strlen(record.type) + strlen(record.message) + 44;
+    if (bytes + lineBytes > query.maxBytes)
+    {
+      out.println(F("{\"truncated\":true}"));
+      return;
+    }
+    printJsonLine(out, record);
+    bytes += lineBytes;
+  }
+}
+
+bool Logger::queryMatches(const LogQuery &query, const char *type, size_t typeLen, const char *text, int64_t uptimeMs) const
+{
+  msgtype level = (msgtype)-1;
+  for (uint8_t i = 0; i < sizeof(levelNames) / sizeof(levelNames[0]); i++)
+  {
+    if (strlen(levelNames[i]) == typeLen && strncmp(type, levelNames[i], typeLen) == 0)
+    {
+      level = (msgtype)i;
+      break;
+    }
+  }
+
+  // unknown types are treated like debug messages
+  if ((level == (msgtype)-1 ? (int)MSG_DEBUG : (int)level) < query.minLevel)
+    return false;
+
+  if (query.sinceMs >= 0 && uptimeMs >= 0 && uptimeMs < query.sinceMs)
+    return false;
+
+  if (text != nullptr && query.grep && query.grep[0] && strstr(text, query.grep) == nullptr)
+    return false;
+
+  return true;
+}
+
+bool Logger::queryMatchesLine(const LogQuery &query, const char *line, int64_t &uptime, bool &older) const
+{
+  older = false;
+  uptime = LOG_UPTIME_UNKNOWN;
+
+  const char *type = strstr(line, "\"Type\":\"");
+  if (type == nullptr)
+    return false;
+  type += 8;
+  const char *typeEnd = strchr(type, '"');
+  if (typeEnd == nullptr)
+    return false;
+
+  if (query.sinceMs >= 0)
+  {
+    const char *timestamp = strstr(line, "\"timestamp\":\"");
+    if (timestamp)
+      uptime = timestampToUptime(timestamp + 13);
+    // a negative uptime (synced time before this boot) is always older
+    if (uptime != LOG_UPTIME_UNKNOWN && uptime < query.sinceMs)
+    {
+      older = true;
+      return false;
+    }
+  }
+
+  if (!queryMatches(query, type, typeEnd - type, nullptr, uptime == LOG_UPTIME_UNKNOWN ? -1 : uptime))
+    return false;
+
+  if (query.grep && query.grep[0])
+  {
+    const char *message = strstr(typeEnd, "\"message\":\"");
+    if (message == nullptr || !jsonStringContains(message + 11, query.grep))
+      return false;
+  }
+  return true;
+}
+
+const char *Logger::nextJsonChar(const char *str, char &c)
+{
+  if (*str == '"' || *str == '\0')
+    return nullptr;
+  if (*str != '\\')
+  {
+    c = *str;
+    return str + 1;
+  }
+
+  switch (str[1])
+  {
+  case '\0':
+    return nullptr;
+  case 'b':
+    c = '\b';
+    break;
+  case 'f':
+    c = '\f';
+    break;
+  case 'n':
+    c = '\n';
+    break;
+  case 'r':
+    c = '\r';
+    break;
+  case 't':
+    c = '\t';
+    break;
+  case 'u':
+  {
+    // printJsonString() only escapes control characters this way
+    unsigned int code = 0;
+    for (uint8_t i = 2; i < 6; i++)
+    {
+      if (!isxdigit((unsigned char)str[i]))
+        return nullptr;
+      code = (code << 4) | (isdigit((unsigned char)str[i]) ? str[i] - '0' : (tolower((unsigned char)str[i]) - 'a' + 10));
+    }
+    c = code < 0x100 ? (char)code : '?';
+    return str + 6;
+  }
+  default: // '"', '\\', '/'
+    c = str[1];
+    break;
+  }
+  return str + 2;
+}
+
+bool Logger::jsonStringContains(const char *str, const char *text)
+{
+  char c;
+  while (true)
+  {
+    const char *p = str;
+    const char *t = text;
+    while (*t && (p = nextJsonChar(p, c)) != nullptr && c == *t)
+      t++;
+    if (*t == '\0')
+      return true;
+
+    // go on with the next character of the string
+    str = nextJsonChar(str, c);
+    if (str == nullptr)
+      return false;
+  }
+}
+
+int64_t Logger::timestampToUptime(const char *timestamp)
+{
+  int days, hours, minutes, seconds;
+  if (sscanf(timestamp, "P%dDT%dH%dM%dS", &days, &hours, &minutes, &seconds) == 4)
+  {
+    return (((int64_t)days * 24 + hours) * 60 + minutes) * 60000LL + seconds * 1000LL;
+  }
+
+  struct tm timeinfo = {};
+  if (sscanf(timestamp, "%d-%d-%dT%d:%d:%d", &timeinfo.tm_year, &timeinfo.tm_mon, &timeinfo.tm_mday,
+             &timeinfo.tm_hour, &timeinfo.tm_min, &timeinfo.tm_sec) == 6)
+  {
+    // the time has not been synced in this boot yet, so the line is from a previous one
+    if (!timeSynced)
+      return -1;
+
+    // local time, see formatUptime()
+    timeinfo.tm_year -= 1900;
+    timeinfo.tm_mon -= 1;
+    timeinfo.tm_isdst = -1;
+    time_t logged = mktime(&timeinfo);
+    int64_t age = (int64_t)(time(NULL) - logged) * 1000;
+    return espMillis() - age;
+  }
+  return LOG_UPTIME_UNKNOWN;
 }
 
 #endif
\ No newline at end of file
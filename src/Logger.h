@@ -11,14 +11,75 @@
 #include "ESP32_FTPClient.h"
 #include <Print.h>
 #include <atomic>
+#include <algorithm>
+#include "LogRingBuffer.hpp"
+#include "LogBinaryFormat.hpp"
 
 #define LOGGER_FILENAME (char *)"nukiBridge.log"
+#define LOGGER_TASK_SIZE 6144       // stack size of the log writer task
+#define LOGGER_FLUSH_INTERVAL 1000  // ms between two flushes of the log writer task
+#define LOGGER_ROTATED_FILENAME (char *)"nukiBridge.1.log" // full log file waiting for the FTP backup
+#define LOGGER_BINARY_FILENAME (char *)"nukiBridge.blog"           // log file in binary format
+#define LOGGER_LINE_BUFFERS 8                                      // tasks that can have an unfinished log line at the same time
+#define LOGGER_BINARY_ROTATED_FILENAME (char *)"nukiBridge.1.blog" // full binary log file waiting for the FTP backup
+#define LOGGER_BACKUP_TASK_SIZE 8192        // stack size of the FTP backup task
+#define LOGGER_BACKUP_RETRY_MIN 10000       // ms before the first retry of a failed FTP backup
+#define LOGGER_BACKUP_RETRY_MAX 600000      // upper limit of the FTP backup retry delay (ms)
+
+#define LOG_QUERY_CHUNK_SIZE 512             // bytes read per step when scanning the log file backwards
+#define LOG_QUERY_LINE_SIZE 768              // max. length of a log file line considered by queries
+#define LOG_QUERY_DEFAULT_BYTES 32768        // default output budget of a log query
+#define LOG_QUERY_MAX_BYTES 262144           // upper limit of the output budget of a log query
+#define LOG_UPTIME_UNKNOWN INT64_MIN         // uptime of a text log line whose timestamp can't be parsed
+
+// Lowest log level compiled into the firmware (0 = TRACE ... 5 = CRITICAL).
+// Build with -DLOGGER_MIN_LEVEL=2 to strip all LOG_TRACE / LOG_DEBUG calls.
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL 0
+#endif
+
+/**
+ * @brief Level-aware log macros.
+ *
+ * The level is checked before the arguments are evaluated or formatted, calls
+ * below LOGGER_MIN_LEVEL are removed by the compiler. The message is a printf
+ * format without "[LEVEL]" prefix and without trailing newline.
+ */
+#define LOG_AT(level, ...)                                                         \
+    do                                                                             \
+    {                                                                              \
+        if ((int)(level) >= LOGGER_MIN_LEVEL && Log && Log->isEnabled(level))      \
+            Log->log(level, __VA_ARGS__);                                          \
+    } while (0)
+
+#define LOG_TRACE(...) LOG_AT(Logger::MSG_TRACE, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(Logger::MSG_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(Logger::MSG_INFO, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_AT(Logger::MSG_WARNING, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(Logger::MSG_ERROR, __VA_ARGS__)
+#define LOG_CRITICAL(...) LOG_AT(Logger::MSG_CRITICAL, __VA_ARGS__)
+
+/**
+ * @brief Filter for Logger::query().
+ */
+struct LogQuery
+{
+    uint32_t tail = 0;                         // Return at most the last n matching lines, 0 = no limit
+    int64_t sinceMs = -1;                      // Only lines logged at or after this uptime (ms) of the current boot, -1 = no limit
+    int minLevel = 0;                          // Lowest level to return (Logger::msgtype)
+    const char *grep = nullptr;                // Only lines containing this text, nullptr = no filter
+    size_t maxBytes = LOG_QUERY_DEFAULT_BYTES; // Output budget, the newest matching lines within the budget are returned
+};
 
 /**
  * @brief Logger class for serial and file-based logging with support for multiple log levels.
  *
  * The Logger supports output to serial and to LittleFS (when not in DEBUG_NUKIBRIDGE mode),
  * including JSON log entries, FTP backup, and various print/println overloads.
+ * Log calls only queue the line, a low-priority writer task appends queued lines
+ * to the log file in batches. If the queue is full, the caller writes the queued
+ * lines itself instead of dropping its line. A full log file is rotated and uploaded
+ * to the FTP server by a separate backup task, so logging never waits for the network.
  */
 class Logger : public Print
 {
@@ -59,6 +120,40 @@ public:
      */
     void clear();
 
+    /**
+     * @brief Writes the matching lines of the log file as JSON lines (oldest first).
+     *
+     * Text log files are scanned backwards from the end in LOG_QUERY_CHUNK_SIZE steps
+     * until enough lines are found, then the selected range is streamed, so the newest
+     * lines within the budget are returned. Binary log files are decoded forwards and
+     * cut at the budget. The log writer is only blocked while the file is opened, so a
+     * slow client doesn't block logging. If the budget is exceeded a final
+     * {"truncated":true} line is written.
+     *
+     * @param query Filter and limits.
+     * @param out Target, e.g. a chunked HTTP response.
+     * @return false if the log file can't be read.
+     */
+    bool query(const LogQuery &query, Print &out);
+
+    /**
+     * @brief Prints a record as JSON line, the format of the text log file.
+     *
+     * @param out Target.
+     * @param record Record to print.
+     */
+    static void printJsonLine(Print &out, const LogRecord &record);
+
+    /**
+     * @brief Name of the active log file (depends on the log format).
+     */
+    const String &getFileName() const { return _logFile; }
+
+    /**
+     * @brief Whether the log file is written in the compact binary format (see LogBinaryFormat.hpp).
+     */
+    bool isBinaryFormat() const { return _binaryFormat; }
+
     /**
      * @brief Reset internal fallback state (used when LittleFS is not usable).
      */
@@ -83,6 +178,26 @@ public:
      */
     msgtype getLevel();
 
+    /**
+     * @brief Check whether messages of a level are logged with the current log level.
+     *
+     * @param level Log level of the message.
+     * @return true If the message would be logged.
+     */
+    bool isEnabled(msgtype level) const { return level >= _currentLogLevel; }
+
+    /**
+     * @brief Log a formatted message with the given level.
+     *
+     * Suppressed levels return before formatting. Prefer the LOG_* macros, they
+     * also skip the argument evaluation.
+     *
+     * @param level Log level of the message.
+     * @param format printf format without "[LEVEL]" prefix.
+     */
+    void log(msgtype level, const char *format, ...) __attribute__((format(printf, 3, 4)));
+    void log(msgtype level, const __FlashStringHelper *format, ...);
+
     /**
      * @brief Convert log level enum to string.
      *
@@ -104,6 +219,39 @@ public:
      */
     void disableBackup();
 
+    /**
+     * @brief Writes all queued log lines to the log file on the calling task.
+     *        Call before restarting / shutting down the ESP.
+     */
+    void flush();
+
+    /**
+     * @brief Number of log lines written to the log file.
+     */
+    uint32_t writtenLines() const { return _writtenLines.load(); }
+
+    /**
+     * @brief Number of log lines dropped because the queue was full and could not be written directly.
+     *
+     * Drops are also reported by a WARNING line in the log file.
+     */
+    uint32_t droppedLines() const { return _droppedLines.load(); }
+
+    /**
+     * @brief Highest number of queued log lines seen.
+     */
+    uint32_t queueHighWater() const { return _queueHighWater.load(); }
+
+    /**
+     * @brief Number of log files uploaded to the FTP server.
+     */
+    uint32_t backupCount() const { return _backupCount.load(); }
+
+    /**
+     * @brief Number of failed FTP upload attempts.
+     */
+    uint32_t backupFailures() const { return _backupFailures.load(); }
+
     // -------------------- Print/Write overrides --------------------
 
     size_t write(uint8_t c) override;
@@ -147,21 +295,228 @@ private:
     Print *_serial;                               // Serial interface for mirroring output
     Preferences *_preferences;                    // Preferences for config values
     String _logFile;                              // Path to log file
-    String _buffer;                               // Internal buffer for streaming
-    int _maxMsgLen;                               // Maximum message length
+    int _maxMsgLen = 128;                         // Maximum message length
     int _maxLogFileSize;                          // Max log file size (KB)
     bool _backupEnabled;                          // Flag to enable backup of log file
-    bool _fileWriteEnabled;                       // Flag to enable writing to Log file
+    bool _fileWriteEnabled = false;               // Flag to enable writing to Log file
+    bool _binaryFormat = false;                   // Write binary records instead of JSON lines
+    LogBinaryWriter _binaryWriter;                // Encoder state of the binary log file
     std::atomic<bool> _logFallBack{false};        // LittleFS failure fallback flag
     std::atomic<bool> _logBackupIsRunning{false}; // FTP backup activity flag
-    msgtype _currentLogLevel;                     // Active log level
+    msgtype _currentLogLevel = MSG_INFO;          // Active log level
+                                                  //
+    LogRingBuffer _queue;                         // Log lines waiting for the writer task
+    TaskHandle_t _writerTaskHandle = nullptr;     // Task writing queued lines to the log file
+    SemaphoreHandle_t _fileMutex = nullptr;       // Serializes access to the log file (recursive)
+    std::atomic<uint32_t> _writtenLines{0};       // Lines written to the log file
+    std::atomic<uint32_t> _droppedLines{0};       // Lines dropped because the queue was full
+    std::atomic<uint32_t> _reportedDrops{0};      // Dropped lines already reported in the log file
+    std::atomic<uint32_t> _queueHighWater{0};     // Highest queue fill level
+                                                  //
+    String _rotatedFile;                          // Path to the rotated log file waiting for backup
+    TaskHandle_t _backupTaskHandle = nullptr;     // Task uploading rotated log files to FTP
+    std::atomic<uint32_t> _backupCount{0};        // Successful FTP uploads
+    std::atomic<uint32_t> _backupFailures{0};     // Failed FTP upload attempts
+
+    /**
+     * @brief Line being assembled by one task from print() / write() calls.
+     */
+    struct LineBuffer
+    {
+        std::atomic<TaskHandle_t> owner{nullptr}; // Task with an unfinished line in this buffer, nullptr if free
+        size_t len = 0;                           // Characters in data
+        bool suppress = false;                    // Discard the rest of the line (level filtered out)
+        char data[LOG_RING_MSG_SIZE];             // Line without terminating newline
+    };
+
+    LineBuffer _lineBuffers[LOGGER_LINE_BUFFERS]; // Per-task line buffers, the last one is shared
+    SemaphoreHandle_t _sharedLineMutex = nullptr; // Guards the shared line buffer
+
+    /**
+     * @brief Task entry point of the log writer task.
+     *
+     * @param parameter Pointer to the Logger instance.
+     */
+    static void writerTask(void *parameter);
+
+    /**
+     * @brief Appends all queued lines to the log file with a single open / close.
+     */
+    void writeQueue();
+
+    /**
+     * @brief Appends a single record to the opened log file in the configured format.
+     *
+     * @param f Opened log file.
+     * @param record Record to write.
+     */
+    void writeRecord(File &f, const LogRecord &record);
+
+    /**
+     * @brief Check a log line against the query filters.
+     *
+     * @param query Filter.
+     * @param type Log level as string, need not be zero terminated.
+     * @param typeLen Length of type.
+     * @param text Zero terminated text searched by the grep filter, nullptr skips the grep filter.
+     * @param uptimeMs Uptime of the line, -1 if unknown (since filter is not applied).
+     * @return true If the line matches.
+     */
+    bool queryMatches(const LogQuery &query, const char *type, size_t typeLen, const char *text, int64_t uptimeMs) const;
+
+    /**
+     * @brief Check a text log file line against the query filters.
+     *
+     * The grep filter is applied to the unescaped message only, like for binary log files.
+     *
+     * @param query Filter.
+     * @param line Zero terminated JSON line.
+     * @param uptime Receives the uptime of the line (see timestampToUptime()), LOG_UPTIME_UNKNOWN if unknown or query.sinceMs isn't set.
+     * @param older Set to true if the line was logged before query.sinceMs.
+     * @return true If the line matches.
+     */
+    bool queryMatchesLine(const LogQuery &query, const char *line, int64_t &uptime, bool &older) const;
+
+    /**
+     * @brief query() for text log files, scans backwards for the start of the selected range.
+     *
+     * The since range ends at the first line from a previous boot: a synced time before
+     * this boot, a synced time while the time isn't synced yet, or (for plain uptimes) a
+     * larger uptime than the line after it.
+     */
+    void queryText(const LogQuery &query, File &f, size_t fileSize, Print &out);
+
+    /**
+     * @brief query() for binary log files, counts the matches in a first pass.
+     */
+    void queryBinary(const LogQuery &query, File &f, size_t fileSize, Print &out);
+
+    /**
+     * @brief Restores the uptime of a text log timestamp.
+     *
+     * @param timestamp Uptime ("P1DT02H03M04S") or local time ("2025-01-02T03:04:05Z").
+     * @return int64_t Uptime in ms, negative if logged before this boot, LOG_UPTIME_UNKNOWN if not parsable.
+     */
+    static int64_t timestampToUptime(const char *timestamp);
+
+    /**
+     * @brief Prints a string as quoted and escaped JSON string.
+     *
+     * @param out Target.
+     * @param str Zero terminated string.
+     */
+    static void printJsonString(Print &out, const char *str);
+
+    /**
+     * @brief Decodes one character of an escaped JSON string value.
+     *
+     * @param str Position in the string value, after the opening quote.
+     * @param c Receives the decoded character.
+     * @return Position of the next character, nullptr at the closing quote or the end of the line.
+     */
+    static const char *nextJsonChar(const char *str, char &c);
+
+    /**
+     * @brief Checks whether an escaped JSON string value contains a text, without unescaping it into a buffer.
+     *
+     * @param str String value, after the opening quote.
+     * @param text Zero terminated text to search for.
+     */
+    static bool jsonStringContains(const char *str, const char *text);
+
+    /**
+     * @brief Task entry point of the FTP backup task.
+     *
+     * Waits for a rotated log file and uploads it. Failed uploads are retried
+     * with an exponential backoff between LOGGER_BACKUP_RETRY_MIN and
+     * LOGGER_BACKUP_RETRY_MAX.
+     *
+     * @param parameter Pointer to the Logger instance.
+     */
+    static void backupTask(void *parameter);
+
+    /**
+     * @brief Moves the full log file aside and starts a new one.
+     *
+     * The rotated file is handed to the backup task. Must be called with the
+     * file mutex held.
+     */
+    void rotate();
+
+    /**
+     * @brief Returns the line buffer owned by the calling task, claims a free one if needed.
+     *
+     * A task owns a buffer only while it has an unfinished line, write() releases it when
+     * the line is complete. Only if more tasks than buffers have unfinished lines at the
+     * same time, the remaining ones share the last buffer and their lines may interleave.
+     *
+     * @param claim Claim a free buffer if the task owns none.
+     * @return LineBuffer* Buffer of the task, nullptr if it owns none (use the shared one).
+     */
+    LineBuffer *taskLineBuffer(bool claim = true);
+
+    /**
+     * @brief Appends output to a line buffer and logs every completed line.
+     *
+     * @param line Line buffer of the calling task.
+     * @param data Output, may contain several or partial lines.
+     * @param size Length of data.
+     */
+    void appendToLine(LineBuffer &line, const char *data, size_t size);
+
+    /**
+     * @brief Parse the level prefix in place, filter message by level and queue it for the log file.
+     *
+     * @param message Complete line, need not be zero terminated.
+     * @param len Length of the line.
+     */
+    void toFile(const char *message, size_t len);
+
+    /**
+     * @brief Queue a message that passed the level filter, optionally mirror to serial.
+     *
+     * @param type Log level as string, need not be zero terminated.
+     * @param typeLen Length of type.
+     * @param message Message without level prefix, need not be zero terminated.
+     * @param len Length of message.
+     */
+    void queueLine(const char *type, size_t typeLen, const char *message, size_t len);
+
+    /**
+     * @brief Formats into a stack buffer and writes the result, shared by the printf() overloads.
+     *
+     * @param format printf format.
+     * @param args Format arguments.
+     * @return size_t Bytes written.
+     */
+    size_t formatLine(const char *format, va_list args);
+
+    /**
+     * @brief Formats and queues a message, shared by the log() overloads.
+     *
+     * @param level Log level of the message.
+     * @param format printf format.
+     * @param args Format arguments.
+     */
+    void logV(msgtype level, const char *format, va_list args);
+
+    /**
+     * @brief Parse a leading "[LEVEL]" prefix.
+     *
+     * @param text Text to check, need not be zero terminated.
+     * @param len Length of text.
+     * @return msgtype Level of the prefix, -1 if there is no known prefix.
+     */
+    static msgtype parseLevelPrefix(const char *text, size_t len);
 
     /**
-     * @brief Write message as JSON to file and optionally to serial.
+     * @brief Check whether text starts with a known level prefix below the current log level.
      *
-     * @param message Message to be logged.
+     * @param text Text to check, need not be zero terminated.
+     * @param len Length of text.
+     * @return true If the line will be dropped anyway.
      */
-    void toFile(String message);
+    bool isSuppressed(const char *text, size_t len) const;
 
     /**
      * @brief Check whether log file exceeds size limit.
@@ -172,7 +527,7 @@ private:
     bool isFileTooBig();
 
     /**
-     * @brief Attempt to upload current log file to FTP server.
+     * @brief Attempt to upload the rotated log file to FTP server, deletes it on success.
      *
      * @return true On success or already running.
      * @return false On failure.
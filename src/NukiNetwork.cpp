@@ -3,8 +3,48 @@
 #include "Logger.h"
 #include "Config.h"
 #include "RestartReason.h"
+#include "WebCfgServerConstants.h"
+#include "NukiLockUtils.h"
 #include "hal/wdt_hal.h"
 
+// NVS keys of the configurable key / param of each HAR field, in HarField order
+static const struct
+{
+    HarField field;
+    const char *key;
+    const char *param;
+} harFieldPrefs[] = {
+    {HarField::State, preference_har_key_state, nullptr},
+    {HarField::RemoteAccessState, preference_har_key_remote_access_state, preference_har_param_remote_access_state},
+    {HarField::WifiRssi, preference_har_key_wifi_rssi, preference_har_param_wifi_rssi},
+    {HarField::Uptime, preference_har_key_uptime, preference_har_param_uptime},
+    {HarField::RestartReasonFw, preference_har_key_restart_reason_fw, preference_har_param_restart_reason_fw},
+    {HarField::RestartReasonEsp, preference_har_key_restart_reason_esp, preference_har_param_restart_reason_esp},
+    {HarField::BridgeVersion, preference_har_key_info_nuki_bridge_version, preference_har_param_info_nuki_bridge_version},
+    {HarField::BridgeBuild, preference_har_key_info_nuki_bridge_build, preference_har_param_info_nuki_bridge_build},
+    {HarField::FreeHeap, preference_har_key_freeheap, preference_har_param_freeheap},
+    {HarField::BleAddress, preference_har_key_ble_address, preference_har_param_ble_address},
+    {HarField::BleStrength, preference_har_key_ble_strength, preference_har_param_ble_strength},
+    {HarField::BleRssi, preference_har_key_ble_rssi, preference_har_param_ble_rssi},
+    {HarField::LockState, preference_har_key_lock_state, preference_har_param_lock_state},
+    {HarField::LockNgoState, preference_har_key_lockngo_state, preference_har_param_lockngo_state},
+    {HarField::LockTrigger, preference_har_key_lock_trigger, preference_har_param_lock_trigger},
+    {HarField::LockNightMode, preference_har_key_lock_night_mode, preference_har_param_lock_night_mode},
+    {HarField::LockCompletionStatus, preference_har_key_lock_completionStatus, preference_har_param_lock_completionStatus},
+    {HarField::DoorSensorState, preference_har_key_doorsensor_state, preference_har_param_doorsensor_state},
+    {HarField::DoorSensorCritical, preference_har_key_doorsensor_critical, preference_har_param_doorsensor_critical},
+    {HarField::KeypadCritical, preference_har_key_keypad_critical, preference_har_param_keypad_critical},
+    {HarField::LockBatteryCritical, preference_har_key_lock_battery_critical, preference_har_param_lock_battery_critical},
+    {HarField::LockBatteryLevel, preference_har_key_lock_battery_level, preference_har_param_lock_battery_level},
+    {HarField::LockBatteryCharging, preference_har_key_lock_battery_charging, preference_har_param_lock_battery_charging},
+    {HarField::BatteryVoltage, preference_har_key_battery_voltage, preference_har_param_battery_voltage},
+    {HarField::BatteryDrain, preference_har_key_battery_drain, preference_har_param_battery_drain},
+    {HarField::BatteryMaxTurnCurrent, preference_har_key_battery_max_turn_current, preference_har_param_battery_max_turn_current},
+    {HarField::BatteryLockDistance, preference_har_key_battery_lock_distance, preference_har_param_battery_lock_distance},
+};
+
+static_assert(sizeof(harFieldPrefs) / sizeof(harFieldPrefs[0]) == (size_t)HarField::Count, "harFieldPrefs must contain every HarField");
+
 NukiNetwork *NukiNetwork::_inst = nullptr;
 
 // Globale oder externe Variablen
@@ -24,18 +64,29 @@ NukiNetwork::NukiNetwork(Preferences *preferences, char *buffer, size_t bufferSi
     _apitoken = new BridgeApiToken(_preferences, preference_api_token);
     _apiEnabled = _preferences->getBool(preference_api_enabled);
     _lockEnabled = preferences->getBool(preference_lock_enabled);
+    _eventStream.setMaxClients(_preferences->getInt(preference_api_event_clients, EVENT_STREAM_DEFAULT_CLIENTS));
     setupDevice();
 }
 
 NukiNetwork::~NukiNetwork()
 {
     // Aufräumen, Webserver stoppen, etc.
+    xSemaphoreTake(_serverSemaphore, portMAX_DELAY);
     if (_server)
     {
         _server->stop();
         delete _server;
         _server = nullptr;
     }
+    xSemaphoreGive(_serverSemaphore);
+    vSemaphoreDelete(_serverSemaphore);
+
+    xSemaphoreTake(_harClientSemaphore, portMAX_DELAY);
+    if (_harSenderTaskHandle)
+    {
+        vTaskDelete(_harSenderTaskHandle);
+        _harSenderTaskHandle = nullptr;
+    }
     if (_httpClient)
     {
         _httpClient->end();
@@ -47,6 +98,10 @@ NukiNetwork::~NukiNetwork()
         delete _udpClient;
         _udpClient = nullptr;
     }
+    xSemaphoreGive(_harClientSemaphore);
+    vSemaphoreDelete(_harClientSemaphore);
+    vSemaphoreDelete(_harBulkSemaphore);
+    vSemaphoreDelete(_harFieldsSemaphore);
 }
 
 void NukiNetwork::setupDevice()
@@ -101,6 +156,9 @@ void NukiNetwork::initialize()
         _homeAutomationPort = _preferences->getInt(preference_har_port, 0);
         _homeAutomationMode = _preferences->getInt(preference_har_mode, 0);          // 0=UDP, 1=REST
         _homeAutomationRestMode = _preferences->getInt(preference_har_rest_mode, 0); // 0=GET, 1=POST
+        _homeAutomationKeepAlive = _preferences->getBool(preference_har_rest_keep_alive, true);
+        _homeAutomationBulk = _preferences->getBool(preference_har_json_enabled, false);
+        _homeAutomationBulkPath = _preferences->getString(preference_har_json_path, "");
 
         _hostname = _preferences->getString(preference_hostname, "");
 
@@ -197,35 +255,11 @@ bool NukiNetwork::update()
 
     if (isConnected() && (_apiEnabled || _homeAutomationEnabled))
     {
-        if (ts - _lastNetworkServiceTs > 30000)
-        { // test all 30 seconds
-            _lastNetworkServiceTs = ts;
-            _networkServicesState = testNetworkServices();
-
-            bool svcBothDown = _homeAutomationEnabled && _apiEnabled && _networkServicesState != NetworkServiceState::OK;
-            bool svcHADown = !_apiEnabled && _networkServicesState != NetworkServiceState::ERROR_REST_API_SERVER;
-            bool svcAPIDown = !_homeAutomationEnabled && _networkServicesState != NetworkServiceState::ERROR_HAR_CLIENT;
-
-            if (svcBothDown || svcHADown || svcAPIDown)
-            { // error in network Services
-                restartNetworkServices(_networkServicesState);
-                delay(1000);
-                _networkServicesState = testNetworkServices(); // test network services again
-
-                bool expectedStateOk =
-                    (_homeAutomationEnabled && _apiEnabled && _networkServicesState == NetworkServiceState::OK) ||
-                    (_homeAutomationEnabled && !_apiEnabled && _networkServicesState == NetworkServiceState::ERROR_REST_API_SERVER) ||
-                    (!_homeAutomationEnabled && _apiEnabled && _networkServicesState == NetworkServiceState::ERROR_HAR_CLIENT);
-
-                if (!expectedStateOk)
-                {
-                    _networkServicesConnectCounter++;
-                    return false;
-                }
-            }
+        if (!superviseNetworkServices(ts))
+        {
+            return false;
         }
 
-        _networkServicesConnectCounter = 0;
         if (forceEnableWebCfgServer && !_webCfgEnabled)
         {
             forceEnableWebCfgServer = false;
@@ -237,7 +271,6 @@ bool NukiNetwork::update()
         {
             forceEnableWebCfgServer = false;
         }
-        delay(2000);
     }
 
     if (_networkServicesState != NetworkServiceState::OK || !isConnected())
@@ -253,7 +286,6 @@ bool NukiNetwork::update()
             delay(200);
             restartEsp(RestartReason::NetworkTimeoutWatchdog);
         }
-        delay(2000);
         return false;
     }
 
@@ -267,11 +299,7 @@ bool NukiNetwork::update()
 
         if (rssi != _lastRssi)
         {
-            String key = _preferences->getString(preference_har_key_wifi_rssi);
-            String param = _preferences->getString(preference_har_param_wifi_rssi);
-
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                sendToHAInt(key.c_str(), param.c_str(), signalStrength());
+            sendToHAInt(HarField::WifiRssi, signalStrength());
             _lastRssi = rssi;
         }
     }
@@ -281,47 +309,20 @@ bool NukiNetwork::update()
         int64_t curUptime = ts / 1000 / 60;
         if (curUptime > _publishedUpTime)
         {
-            String key = _preferences->getString(preference_har_key_uptime);
-            String param = _preferences->getString(preference_har_param_uptime);
-
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                sendToHAULong(key.c_str(), param.c_str(), curUptime);
+            sendToHAULong(HarField::Uptime, curUptime);
             _publishedUpTime = curUptime;
         }
 
         if (_lastMaintenanceTs == 0)
         {
-            String key = _preferences->getString(preference_har_key_restart_reason_fw);
-            String param = _preferences->getString(preference_har_param_restart_reason_fw);
-
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                sendToHAString(key.c_str(), param.c_str(), getRestartReason().c_str());
-
-            key = _preferences->getString(preference_har_key_restart_reason_esp);
-            param = _preferences->getString(preference_har_param_restart_reason_esp);
-
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                sendToHAString(key.c_str(), param.c_str(), getEspRestartReason().c_str());
-
-            key = _preferences->getString(preference_har_key_info_nuki_bridge_version);
-            param = _preferences->getString(preference_har_param_info_nuki_bridge_version);
-
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                sendToHAString(key.c_str(), param.c_str(), NUKI_REST_BRIDGE_VERSION);
-
-            key = _preferences->getString(preference_har_key_info_nuki_bridge_build);
-            param = _preferences->getString(preference_har_param_info_nuki_bridge_build);
-
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                sendToHAString(key.c_str(), param.c_str(), NUKI_REST_BRIDGE_BUILD);
+            sendToHAString(HarField::RestartReasonFw, getRestartReason().c_str());
+            sendToHAString(HarField::RestartReasonEsp, getEspRestartReason().c_str());
+            sendToHAString(HarField::BridgeVersion, NUKI_REST_BRIDGE_VERSION);
+            sendToHAString(HarField::BridgeBuild, NUKI_REST_BRIDGE_BUILD);
         }
         if (_sendDebugInfo)
         {
-            String key = _preferences->getString(preference_har_key_freeheap);
-            String param = _preferences->getString(preference_har_param_freeheap);
-
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                sendToHAUInt(key.c_str(), param.c_str(), esp_get_free_heap_size());
+            sendToHAUInt(HarField::FreeHeap, esp_get_free_heap_size());
         }
         _lastMaintenanceTs = ts;
     }
@@ -523,52 +524,95 @@ void NukiNetwork::sendToHAString(const char *path, const char *param, const char
     }
 }
 
+void NukiNetwork::sendDataToHA(HarField field, const char *value)
+{
+    xSemaphoreTake(_harFieldsSemaphore, portMAX_DELAY);
+    const HarFieldConfig &config = _harFields[(uint8_t)field];
+    sendDataToHA(config.key, config.param, value);
+    xSemaphoreGive(_harFieldsSemaphore);
+}
+
+void NukiNetwork::sendToHAFloat(HarField field, const float value, uint8_t precision)
+{
+    xSemaphoreTake(_harFieldsSemaphore, portMAX_DELAY);
+    const HarFieldConfig &config = _harFields[(uint8_t)field];
+    sendToHAFloat(config.key, config.param, value, precision);
+    xSemaphoreGive(_harFieldsSemaphore);
+}
+
+void NukiNetwork::sendToHAInt(HarField field, const int value)
+{
+    xSemaphoreTake(_harFieldsSemaphore, portMAX_DELAY);
+    const HarFieldConfig &config = _harFields[(uint8_t)field];
+    sendToHAInt(config.key, config.param, value);
+    xSemaphoreGive(_harFieldsSemaphore);
+}
+
+void NukiNetwork::sendToHAUInt(HarField field, const unsigned int value)
+{
+    xSemaphoreTake(_harFieldsSemaphore, portMAX_DELAY);
+    const HarFieldConfig &config = _harFields[(uint8_t)field];
+    sendToHAUInt(config.key, config.param, value);
+    xSemaphoreGive(_harFieldsSemaphore);
+}
+
+void NukiNetwork::sendToHAULong(HarField field, const unsigned long value)
+{
+    xSemaphoreTake(_harFieldsSemaphore, portMAX_DELAY);
+    const HarFieldConfig &config = _harFields[(uint8_t)field];
+    sendToHAULong(config.key, config.param, value);
+    xSemaphoreGive(_harFieldsSemaphore);
+}
+
+void NukiNetwork::sendToHAString(HarField field, const char *value)
+{
+    xSemaphoreTake(_harFieldsSemaphore, portMAX_DELAY);
+    const HarFieldConfig &config = _harFields[(uint8_t)field];
+    sendToHAString(config.key, config.param, value);
+    xSemaphoreGive(_harFieldsSemaphore);
+}
+
+void NukiNetwork::loadHARFields()
+{
+    xSemaphoreTake(_harFieldsSemaphore, portMAX_DELAY);
+    for (const auto &prefs : harFieldPrefs)
+    {
+        HarFieldConfig &config = _harFields[(uint8_t)prefs.field];
+        config.key[0] = '\0';
+        config.param[0] = '\0';
+
+        if (_preferences->isKey(prefs.key))
+            _preferences->getString(prefs.key, config.key, sizeof(config.key));
+        if (prefs.param && _preferences->isKey(prefs.param))
+            _preferences->getString(prefs.param, config.param, sizeof(config.param));
+    }
+    xSemaphoreGive(_harFieldsSemaphore);
+}
+
 void NukiNetwork::sendToHALockBleAddress(const std::string &address)
 {
     if (_homeAutomationEnabled && _networkServicesState != NetworkServiceState::ERROR_HAR_CLIENT)
     {
-
-        String key = _preferences->getString(preference_har_key_ble_address);
-        String param = _preferences->getString(preference_har_param_ble_address);
-
-        if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-            sendDataToHA(key.c_str(), param.c_str(), address.c_str());
+        sendDataToHA(HarField::BleAddress, address.c_str());
     }
 }
 
 void NukiNetwork::sendToHABatteryReport(const NukiLock::BatteryReport &batteryReport)
 {
-    if (_homeAutomationEnabled && _networkServicesState != NetworkServiceState::ERROR_HAR_CLIENT)
+    if (_homeAutomationEnabled && _networkServicesState != NetworkServiceState::ERROR_HAR_CLIENT && _homeAutomationBulk)
     {
-        String key;
-        key.reserve(384);
-        String param;
-        param.reserve(128);
+        xSemaphoreTake(_harBulkSemaphore, portMAX_DELAY);
+        batteryReportToJson(_harBulkDoc[HAR_CAT_BATTERY_REPORT].to<JsonObject>(), batteryReport, batteryReport, true);
+        xSemaphoreGive(_harBulkSemaphore);
 
-        key = _preferences->getString(preference_har_key_battery_voltage);
-        param = _preferences->getString(preference_har_param_battery_voltage);
-        if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-        {
-            sendToHAFloat(key.c_str(), param.c_str(), (float)batteryReport.batteryVoltage / 1000.0, true);
-        }
-        key = _preferences->getString(preference_har_key_battery_drain);
-        param = _preferences->getString(preference_har_param_battery_drain);
-        if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-        {
-            sendToHAFloat(key.c_str(), param.c_str(), batteryReport.batteryDrain, true); // milliwatt seconds
-        }
-        key = _preferences->getString(preference_har_key_battery_max_turn_current);
-        param = _preferences->getString(preference_har_param_battery_max_turn_current);
-        if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-        {
-            sendToHAFloat(key.c_str(), param.c_str(), (float)batteryReport.maxTurnCurrent / 1000.0, true);
-        }
-        key = _preferences->getString(preference_har_key_battery_lock_distance);
-        param = _preferences->getString(preference_har_param_battery_lock_distance);
-        if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-        {
-            sendToHAFloat(key.c_str(), param.c_str(), batteryReport.lockDistance, true); // degrees
-        }
+        notifyHARSender();
+    }
+    else if (_homeAutomationEnabled && _networkServicesState != NetworkServiceState::ERROR_HAR_CLIENT)
+    {
+        sendToHAFloat(HarField::BatteryVoltage, (float)batteryReport.batteryVoltage / 1000.0, true);
+        sendToHAFloat(HarField::BatteryDrain, batteryReport.batteryDrain, true); // milliwatt seconds
+        sendToHAFloat(HarField::BatteryMaxTurnCurrent, (float)batteryReport.maxTurnCurrent / 1000.0, true);
+        sendToHAFloat(HarField::BatteryLockDistance, batteryReport.lockDistance, true); // degrees
     }
 }
 
@@ -576,45 +620,157 @@ void NukiNetwork::sendToHABleRssi(const int &rssi)
 {
     if (_homeAutomationEnabled && _networkServicesState != NetworkServiceState::ERROR_HAR_CLIENT)
     {
-        String key = _preferences->getString(preference_har_key_ble_rssi);
-        String param = _preferences->getString(preference_har_param_ble_rssi);
+        sendToHAInt(HarField::BleRssi, rssi);
+    }
+}
+
+void NukiNetwork::sendToHAKeyTurnerStateBulk(const NukiLock::KeyTurnerState &keyTurnerState, const NukiLock::KeyTurnerState &lastKeyTurnerState)
+{
+    bool first = _firstTunerStateSent;
+
+    xSemaphoreTake(_harBulkSemaphore, portMAX_DELAY);
+
+    // merge into a not yet sent diff, so no change gets lost
+    JsonObject json = _harBulkDoc[HAR_CAT_KEY_TURN_STATE].as<JsonObject>();
+    if (json.isNull())
+        json = _harBulkDoc[HAR_CAT_KEY_TURN_STATE].to<JsonObject>();
+
+    keyTurnerStateToJson(json, keyTurnerState, lastKeyTurnerState, first);
+
+    // nothing changed
+    if (json.size() == 0)
+        _harBulkDoc.remove(HAR_CAT_KEY_TURN_STATE);
+
+    xSemaphoreGive(_harBulkSemaphore);
+
+    _firstTunerStateSent = false;
+    notifyHARSender();
+}
+
+void NukiNetwork::keyTurnerStateToJson(JsonObject json, const NukiLock::KeyTurnerState &keyTurnerState, const NukiLock::KeyTurnerState &lastKeyTurnerState, bool all)
+{
+    if (all || keyTurnerState.lockState != lastKeyTurnerState.lockState)
+        json[F("lockState")] = (int)keyTurnerState.lockState;
+    if (all || keyTurnerState.lockNgoTimer != lastKeyTurnerState.lockNgoTimer)
+        json[F("lockNgoTimer")] = (int)keyTurnerState.lockNgoTimer;
+    if (all || keyTurnerState.trigger != lastKeyTurnerState.trigger)
+        json[F("trigger")] = (int)keyTurnerState.trigger;
+    if (all || keyTurnerState.nightModeActive != lastKeyTurnerState.nightModeActive)
+        json[F("nightModeActive")] = (int)keyTurnerState.nightModeActive;
+    if (all || keyTurnerState.lastLockActionCompletionStatus != lastKeyTurnerState.lastLockActionCompletionStatus)
+        json[F("completionStatus")] = (int)keyTurnerState.lastLockActionCompletionStatus;
+    if (all || keyTurnerState.doorSensorState != lastKeyTurnerState.doorSensorState)
+        json[F("doorSensorState")] = (int)keyTurnerState.doorSensorState;
+
+    if (all || keyTurnerState.criticalBatteryState != lastKeyTurnerState.criticalBatteryState)
+    {
+        json[F("batteryCritical")] = (int)((keyTurnerState.criticalBatteryState & 1) == 1);
+        json[F("batteryLevel")] = (int)((keyTurnerState.criticalBatteryState & 0b11111100) >> 1);
+        json[F("batteryCharging")] = (int)((keyTurnerState.criticalBatteryState & 2) == 2);
+    }
+
+    if (all || keyTurnerState.accessoryBatteryState != lastKeyTurnerState.accessoryBatteryState)
+    {
+        bool keypadCritical = keyTurnerState.accessoryBatteryState != 255 ? ((keyTurnerState.accessoryBatteryState & 1) == 1 ? (keyTurnerState.accessoryBatteryState & 3) == 3 : false) : false;
+        bool doorSensorCritical = keyTurnerState.accessoryBatteryState != 255 ? ((keyTurnerState.accessoryBatteryState & 4) == 4 ? (keyTurnerState.accessoryBatteryState & 12) == 12 : false) : false;
+        json[F("keypadBatteryCritical")] = (int)keypadCritical;
+        json[F("doorSensorBatteryCritical")] = (int)doorSensorCritical;
+    }
+
+    if (all || keyTurnerState.remoteAccessStatus != lastKeyTurnerState.remoteAccessStatus)
+        json[F("remoteAccessStatus")] = (int)keyTurnerState.remoteAccessStatus;
+    if (keyTurnerState.bleConnectionStrength != 1 && (all || keyTurnerState.bleConnectionStrength != lastKeyTurnerState.bleConnectionStrength))
+        json[F("bleConnectionStrength")] = (int)keyTurnerState.bleConnectionStrength;
+}
+
+void NukiNetwork::batteryReportToJson(JsonObject json, const NukiLock::BatteryReport &batteryReport, const NukiLock::BatteryReport &lastBatteryReport, bool all)
+{
+    if (all || batteryReport.batteryVoltage != lastBatteryReport.batteryVoltage)
+        json[F("batteryVoltage")] = (float)batteryReport.batteryVoltage / 1000.0;
+    if (all || batteryReport.batteryDrain != lastBatteryReport.batteryDrain)
+        json[F("batteryDrain")] = batteryReport.batteryDrain; // milliwatt seconds
+    if (all || batteryReport.maxTurnCurrent != lastBatteryReport.maxTurnCurrent)
+        json[F("maxTurnCurrent")] = (float)batteryReport.maxTurnCurrent / 1000.0;
+    if (all || batteryReport.lockDistance != lastBatteryReport.lockDistance)
+        json[F("lockDistance")] = batteryReport.lockDistance; // degrees
+}
+
+void NukiNetwork::streamKeyTurnerState(const NukiLock::KeyTurnerState &keyTurnerState, const NukiLock::KeyTurnerState &lastKeyTurnerState)
+{
+    if (_eventStream.clientCount() == 0)
+    {
+        return;
+    }
+
+    JsonDocument json;
+    keyTurnerStateToJson(json.to<JsonObject>(), keyTurnerState, lastKeyTurnerState, false);
+    if (json.size() == 0)
+    {
+        return;
+    }
+
+    char data[EVENT_STREAM_BUFFER_SIZE / 2];
+    serializeJson(json, data, sizeof(data));
+    _eventStream.publish("state", data);
+}
+
+void NukiNetwork::streamBatteryReport(const NukiLock::BatteryReport &batteryReport, const NukiLock::BatteryReport &lastBatteryReport)
+{
+    if (_eventStream.clientCount() == 0)
+    {
+        return;
+    }
+
+    JsonDocument json;
+    batteryReportToJson(json.to<JsonObject>(), batteryReport, lastBatteryReport, false);
+    if (json.size() == 0)
+    {
+        return;
+    }
+
+    char data[EVENT_STREAM_BUFFER_SIZE / 2];
+    serializeJson(json, data, sizeof(data));
+    _eventStream.publish("battery", data);
+}
 
-        if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-            sendToHAInt(key.c_str(), param.c_str(), rssi);
+void NukiNetwork::acceptEventStream(WebServer &server)
+{
+    JsonDocument json;
+    const char *event = nullptr;
+
+    // new clients start with the full cached state, later events only carry changes
+    if (_lockSnapshotRequestedCallback != nullptr && _lockSnapshotRequestedCallback(QUERY_COMMAND_LOCKSTATE, json) > 0)
+    {
+        serializeJson(json, _buffer, _bufferSize);
+        event = "state";
+    }
+
+    if (!_eventStream.accept(server, event, _buffer))
+    {
+        json.clear();
+        json[F("result")] = "too many clients";
+        sendResponse(json, false, 503);
     }
 }
 
 void NukiNetwork::sendToHAKeyTurnerState(const NukiLock::KeyTurnerState &keyTurnerState, const NukiLock::KeyTurnerState &lastKeyTurnerState)
 {
-    if (_homeAutomationEnabled && _networkServicesState != NetworkServiceState::ERROR_HAR_CLIENT)
+    if (_homeAutomationEnabled && _networkServicesState != NetworkServiceState::ERROR_HAR_CLIENT && _homeAutomationBulk)
+    {
+        sendToHAKeyTurnerStateBulk(keyTurnerState, lastKeyTurnerState);
+    }
+    else if (_homeAutomationEnabled && _networkServicesState != NetworkServiceState::ERROR_HAR_CLIENT)
     {
         char str[50];
         memset(&str, 0, sizeof(str));
 
-        String key;
-        key.reserve(384);
-        String param;
-        param.reserve(128);
-
         if (_homeAutomationEnabled)
         {
             lockstateToString(keyTurnerState.lockState, str);
 
-            key = _preferences->getString(preference_har_key_lock_state);
-            param = _preferences->getString(preference_har_param_lock_state);
+            sendToHAInt(HarField::LockState, (int)keyTurnerState.lockState);
 
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-            {
-                sendToHAInt(key.c_str(), param.c_str(), (int)keyTurnerState.lockState);
-            }
-
-            key = _preferences->getString(preference_har_key_lockngo_state);
-            param = _preferences->getString(preference_har_param_lockngo_state);
-
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-            {
-                sendToHAInt(key.c_str(), param.c_str(), (int)keyTurnerState.lockNgoTimer);
-            }
+            sendToHAInt(HarField::LockNgoState, (int)keyTurnerState.lockNgoTimer);
 
             memset(&str, 0, sizeof(str));
 
@@ -622,35 +778,17 @@ void NukiNetwork::sendToHAKeyTurnerState(const NukiLock::KeyTurnerState &keyTurn
 
             if (_firstTunerStateSent || keyTurnerState.trigger != lastKeyTurnerState.trigger)
             {
-                key = _preferences->getString(preference_har_key_lock_trigger);
-                param = _preferences->getString(preference_har_param_lock_trigger);
-
-                if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                {
-                    sendToHAInt(key.c_str(), param.c_str(), (int)keyTurnerState.trigger);
-                }
+                sendToHAInt(HarField::LockTrigger, (int)keyTurnerState.trigger);
             }
 
-            key = _preferences->getString(preference_har_key_lock_night_mode);
-            param = _preferences->getString(preference_har_param_lock_night_mode);
-
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-            {
-                sendToHAInt(key.c_str(), param.c_str(), (int)keyTurnerState.nightModeActive);
-            }
+            sendToHAInt(HarField::LockNightMode, (int)keyTurnerState.nightModeActive);
 
             memset(&str, 0, sizeof(str));
             NukiLock::completionStatusToString(keyTurnerState.lastLockActionCompletionStatus, str);
 
             if (_firstTunerStateSent || keyTurnerState.lastLockActionCompletionStatus != lastKeyTurnerState.lastLockActionCompletionStatus)
             {
-                key = _preferences->getString(preference_har_key_lock_completionStatus);
-                param = _preferences->getString(preference_har_param_lock_completionStatus);
-
-                if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                {
-                    sendToHAInt(key.c_str(), param.c_str(), (int)keyTurnerState.lastLockActionCompletionStatus);
-                }
+                sendToHAInt(HarField::LockCompletionStatus, (int)keyTurnerState.lastLockActionCompletionStatus);
             }
 
             memset(&str, 0, sizeof(str));
@@ -659,13 +797,7 @@ void NukiNetwork::sendToHAKeyTurnerState(const NukiLock::KeyTurnerState &keyTurn
 
             if (_firstTunerStateSent || keyTurnerState.doorSensorState != lastKeyTurnerState.doorSensorState)
             {
-                key = _preferences->getString(preference_har_key_doorsensor_state);
-                param = _preferences->getString(preference_har_param_doorsensor_state);
-
-                if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                {
-                    sendToHAInt(key.c_str(), param.c_str(), (int)keyTurnerState.doorSensorState);
-                }
+                sendToHAInt(HarField::DoorSensorState, (int)keyTurnerState.doorSensorState);
             }
 
             bool critical = (keyTurnerState.criticalBatteryState & 1) == 1;
@@ -675,72 +807,28 @@ void NukiNetwork::sendToHAKeyTurnerState(const NukiLock::KeyTurnerState &keyTurn
 
             if ((_firstTunerStateSent || keyTurnerState.criticalBatteryState != lastKeyTurnerState.criticalBatteryState))
             {
-                key = _preferences->getString(preference_har_key_lock_battery_critical);
-                param = _preferences->getString(preference_har_param_lock_battery_critical);
-
-                if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                {
-                    sendToHAInt(key.c_str(), param.c_str(), (int)critical);
-                }
-
-                key = _preferences->getString(preference_har_key_lock_battery_level);
-                param = _preferences->getString(preference_har_param_lock_battery_level);
-
-                if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                {
-                    sendToHAInt(key.c_str(), param.c_str(), (int)level);
-                }
-
-                key = _preferences->getString(preference_har_key_lock_battery_charging);
-                param = _preferences->getString(preference_har_param_lock_battery_charging);
-
-                if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                {
-                    sendToHAInt(key.c_str(), param.c_str(), (int)charging);
-                }
+                sendToHAInt(HarField::LockBatteryCritical, (int)critical);
+                sendToHAInt(HarField::LockBatteryLevel, (int)level);
+                sendToHAInt(HarField::LockBatteryCharging, (int)charging);
             }
 
             if ((_firstTunerStateSent || keyTurnerState.accessoryBatteryState != lastKeyTurnerState.accessoryBatteryState))
             {
-                key = _preferences->getString(preference_har_key_keypad_critical);
-                param = _preferences->getString(preference_har_param_keypad_critical);
-
-                if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                {
-                    sendToHAInt(key.c_str(), param.c_str(), (int)keypadCritical);
-                }
+                sendToHAInt(HarField::KeypadCritical, (int)keypadCritical);
             }
 
             bool doorSensorCritical = keyTurnerState.accessoryBatteryState != 255 ? ((keyTurnerState.accessoryBatteryState & 4) == 4 ? (keyTurnerState.accessoryBatteryState & 12) == 12 : false) : false;
 
             if ((_firstTunerStateSent || keyTurnerState.accessoryBatteryState != lastKeyTurnerState.accessoryBatteryState))
             {
-                key = _preferences->getString(preference_har_key_doorsensor_critical);
-                param = _preferences->getString(preference_har_param_doorsensor_critical);
-
-                if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                {
-                    sendToHAInt(key.c_str(), param.c_str(), (int)doorSensorCritical);
-                }
+                sendToHAInt(HarField::DoorSensorCritical, (int)doorSensorCritical);
             }
 
-            key = _preferences->getString(preference_har_key_remote_access_state);
-            param = _preferences->getString(preference_har_param_remote_access_state);
-
-            if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-            {
-                sendToHAInt(key.c_str(), param.c_str(), (int)keyTurnerState.remoteAccessStatus);
-            }
+            sendToHAInt(HarField::RemoteAccessState, (int)keyTurnerState.remoteAccessStatus);
 
             if (keyTurnerState.bleConnectionStrength != 1)
             {
-                key = _preferences->getString(preference_har_key_ble_strength);
-                param = _preferences->getString(preference_har_param_ble_strength);
-
-                if ((key && _homeAutomationMode == 1) || (param && _homeAutomationMode == 0))
-                {
-                    sendToHAInt(key.c_str(), param.c_str(), (int)keyTurnerState.bleConnectionStrength);
-                }
+                sendToHAInt(HarField::BleStrength, (int)keyTurnerState.bleConnectionStrength);
             }
 
             _firstTunerStateSent = false;
@@ -750,102 +838,339 @@ void NukiNetwork::sendToHAKeyTurnerState(const NukiLock::KeyTurnerState &keyTurn
 
 void NukiNetwork::sendDataToHA(const char *key, const char *param, const char *value)
 {
-    // --- UDP Mode ---
-    if (_homeAutomationMode == 0) // UDP
-    {
-        if (!param || !*param)
-            return;
-        char message[384];
-        snprintf(message, sizeof(message), "%s=%s", param, value ? value : "");
-
-        _udpClient->beginPacket(_homeAutomationAdress.c_str(), _homeAutomationPort);
-        _udpClient->write(reinterpret_cast<const uint8_t *>(message), strlen(message));
-        _udpClient->endPacket();
+    // skip reports that cannot be sent in the current mode
+    if (_homeAutomationMode == 0 && (!param || !*param))
+        return;
+    if (_homeAutomationMode == 1 && (!key || !*key))
         return;
+
+    if (!_harQueue.push(key, param, value))
+    {
+        Log->println(F("[WARNING] Home Automation report queue full, oldest report dropped"));
     }
 
-    if (_homeAutomationMode == 1) // REST
+    notifyHARSender();
+}
+
+void NukiNetwork::notifyHARSender()
+{
+    if (_harSenderTaskHandle)
     {
-        if (!key || !*key)
-            return;
+        xTaskNotifyGive(_harSenderTaskHandle);
+    }
+}
 
-        const size_t BUFFER_SIZE = 256;
-        char url[BUFFER_SIZE];
-        char postData[BUFFER_SIZE];
+void NukiNetwork::harSenderTask(void *parameter)
+{
+    NukiNetwork *network = static_cast<NukiNetwork *>(parameter);
+    HomeAutomationReport report;
 
-        // Build base URL
-        snprintf(url, BUFFER_SIZE, "http://");
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+
+        // send everything that has been queued up in the meantime
+        while (network->_harQueue.pop(report))
+        {
+            if (network->transmitToHA(report))
+                network->_harSent++;
+            else
+                network->_harFailed++;
+        }
 
-        // If user name and password are available, add authentication
-        if (_homeAutomationUser && _homeAutomationPassword)
+        if (network->_homeAutomationBulk)
         {
-            strncat(url, _homeAutomationUser.c_str(), BUFFER_SIZE - strlen(url) - 1);
-            strncat(url, ":", BUFFER_SIZE - strlen(url) - 1);
-            strncat(url, _homeAutomationPassword.c_str(), BUFFER_SIZE - strlen(url) - 1);
-            strncat(url, "@", BUFFER_SIZE - strlen(url) - 1);
+            network->transmitBulkToHA();
         }
+    }
+}
+
+HTTPClient *NukiNetwork::createHttpClient()
+{
+    HTTPClient *client = new HTTPClient();
+    if (client)
+    {
+        client->setReuse(_homeAutomationKeepAlive);
+        client->setConnectTimeout(HAR_REQUEST_TIMEOUT);
+        client->setTimeout(HAR_REQUEST_TIMEOUT);
+    }
+    return client;
+}
+
+void NukiNetwork::buildHAUrl(const char *path, char *url, size_t size)
+{
+    // Build base URL
+    snprintf(url, size, "http://");
+
+    // If user name and password are available, add authentication
+    if (_homeAutomationUser && _homeAutomationPassword)
+    {
+        strncat(url, _homeAutomationUser.c_str(), size - strlen(url) - 1);
+        strncat(url, ":", size - strlen(url) - 1);
+        strncat(url, _homeAutomationPassword.c_str(), size - strlen(url) - 1);
+        strncat(url, "@", size - strlen(url) - 1);
+    }
+
+    // Add host + port
+    strncat(url, _homeAutomationAdress.c_str(), size - strlen(url) - 1);
+    if (_homeAutomationPort)
+    {
+        char portStr[7]; // ':' + max. 5 digits + zero termination
+        snprintf(portStr, sizeof(portStr), ":%d", _homeAutomationPort);
+        strncat(url, portStr, size - strlen(url) - 1);
+    }
+
+    // Add Path
+    strncat(url, "/", size - strlen(url) - 1);
+    strncat(url, path, size - strlen(url) - 1);
+}
+
+bool NukiNetwork::requestHA(const char *url, const char *contentType, const char *postData)
+{
+    int httpCode = -1;
+    bool reused = false;
+
+    // A kept-alive connection may have been closed by the server in the meantime.
+    // In that case the request fails immediately and is retried once on a new connection.
+    for (uint8_t attempt = 0; attempt < 2; attempt++)
+    {
+        reused = _homeAutomationKeepAlive && _httpClient->connected();
+
+        // Send HTTP request
+        _httpClient->begin(url);
+        _httpClient->addHeader("Content-Type", contentType);
+        if (postData == nullptr) // GET
+            httpCode = _httpClient->GET();
+        else // POST
+            httpCode = _httpClient->POST(postData);
 
-        // Add host + port
-        strncat(url, _homeAutomationAdress.c_str(), BUFFER_SIZE - strlen(url) - 1);
-        if (_homeAutomationPort)
+        if (httpCode > 0 || !reused)
+            break;
+
+        _harReconnects++;
+        _httpClient->end();
+    }
+
+    bool success = false;
+
+    if (httpCode > 0)
+    {
+        if (reused)
+            _harReusedConnections++;
+        else
+            _harNewConnections++;
+
+        success = httpCode < 400;
+        if (!success)
         {
-            char portStr[6]; // Max. 5 digits + zero termination
-            snprintf(portStr, sizeof(portStr), ":%d", _homeAutomationPort);
-            strncat(url, portStr, BUFFER_SIZE - strlen(url) - 1);
+            Log->printf(F("[ERROR] HTTP request to Home Automation failed with code %d\n"), httpCode);
         }
+    }
+    else
+    {
+        Log->printf(F("[ERROR] HTTP request failed: %s\n"), _httpClient->errorToString(httpCode).c_str());
+    }
+
+    // keeps the connection open if keep-alive is enabled and the server allows it
+    _httpClient->end();
+    return success;
+}
 
-        // Add Path
-        strncat(url, "/", BUFFER_SIZE - strlen(url) - 1);
-        strncat(url, key, BUFFER_SIZE - strlen(url) - 1);
+bool NukiNetwork::transmitToHA(const HomeAutomationReport &report)
+{
+    const char *key = report.key;
+    const char *param = report.param;
+    const char *value = report.value;
+    bool success = false;
+
+    xSemaphoreTake(_harClientSemaphore, portMAX_DELAY);
 
-        int httpCode = -1;
+    // --- UDP Mode ---
+    if (_homeAutomationMode == 0 && _udpClient) // UDP
+    {
+        char message[384];
+        snprintf(message, sizeof(message), "%s=%s", param, value);
+
+        _udpClient->beginPacket(_homeAutomationAdress.c_str(), _homeAutomationPort);
+        _udpClient->write(reinterpret_cast<const uint8_t *>(message), strlen(message));
+        success = _udpClient->endPacket() == 1;
+    }
+    else if (_homeAutomationMode == 1 && _httpClient) // REST
+    {
+        const size_t BUFFER_SIZE = 256;
+        char url[BUFFER_SIZE];
+        char postData[BUFFER_SIZE] = {0};
+
+        buildHAUrl(key, url, BUFFER_SIZE);
 
         if (_homeAutomationRestMode == 0) // GET
         {
 
-            if (param && *param)
+            if (*param)
             {
                 strncat(url, "/", BUFFER_SIZE - strlen(url) - 1);
                 strncat(url, param, BUFFER_SIZE - strlen(url) - 1);
             }
-            if (value && *value)
+            if (*value)
             {
                 strncat(url, value, BUFFER_SIZE - strlen(url) - 1);
             }
 
-            // Send HTTP request
-            _httpClient->begin(url);
-            _httpClient->addHeader("Content-Type", "application/x-www-form-urlencoded");
-            httpCode = _httpClient->GET();
+            success = requestHA(url, "application/x-www-form-urlencoded", nullptr);
         }
         else // POST
         {
-            if (param && *param)
+            if (*param)
             {
                 strncat(postData, param, BUFFER_SIZE - strlen(postData) - 1);
             }
-            if (value && *value)
+            if (*value)
             {
                 strncat(postData, value, BUFFER_SIZE - strlen(postData) - 1);
             }
 
-            // Send HTTP request
-            _httpClient->begin(url);
-            _httpClient->addHeader("Content-Type", "application/x-www-form-urlencoded");
-            httpCode = _httpClient->POST(postData);
+            success = requestHA(url, "application/x-www-form-urlencoded", postData);
         }
+    }
+
+    xSemaphoreGive(_harClientSemaphore);
+    return success;
+}
+
+void NukiNetwork::transmitBulkToHA()
+{
+    char message[HAR_BULK_MAX_SIZE];
+    JsonDocument pending;
+
+    // the last attempt failed, wait for the backoff to expire
+    if (_harBulkRetryTs != 0 && espMillis() < _harBulkRetryTs)
+        return;
 
-        if (httpCode > 0)
+    xSemaphoreTake(_harBulkSemaphore, portMAX_DELAY);
+    if (_harBulkDoc.isNull() || _harBulkDoc.size() == 0)
+    {
+        xSemaphoreGive(_harBulkSemaphore);
+        return;
+    }
+    if (_homeAutomationMode == 1 && _homeAutomationBulkPath.isEmpty())
+    {
+        // nothing can be sent until the path is configured (which restarts the bridge)
+        _harBulkDoc.clear();
+        xSemaphoreGive(_harBulkSemaphore);
+        if (!_harBulkPathWarned)
         {
-            Log->println(_httpClient->getString());
+            Log->println(F("[WARNING] Home Automation JSON report enabled without a path, reports are discarded"));
+            _harBulkPathWarned = true;
         }
-        else
+        _harFailed++;
+        return;
+    }
+    pending.set(_harBulkDoc);
+    xSemaphoreGive(_harBulkSemaphore);
+
+    if (measureJson(pending) < sizeof(message))
+    {
+        size_t len = serializeJson(pending, message, sizeof(message));
+        if (!sendBulkMessageToHA(message, len))
         {
-            Log->printf(F("[ERROR] HTTP request failed: %s\n"), _httpClient->errorToString(httpCode).c_str());
+            bulkSendFailed(); // kept for the next attempt of the sender task
+            return;
         }
+        _harBulkSent++;
+        removeDeliveredBulk(pending);
+        bulkSendSucceeded();
+        return;
+    }
 
-        _httpClient->end();
+    // too large for a single report, send one report per category
+    for (JsonPair category : pending.as<JsonObject>())
+    {
+        JsonDocument part;
+        part[category.key()] = category.value();
+
+        if (measureJson(part) >= sizeof(message))
+        {
+            Log->printf("[WARNING] Home Automation JSON report category %s exceeds %d bytes, discarded\n", category.key().c_str(), HAR_BULK_MAX_SIZE);
+            _harFailed++;
+            removeDeliveredBulk(part);
+            continue;
+        }
+
+        size_t len = serializeJson(part, message, sizeof(message));
+        if (!sendBulkMessageToHA(message, len))
+        {
+            bulkSendFailed(); // the rest is kept for the next attempt of the sender task
+            return;
+        }
+        _harBulkSent++;
+        removeDeliveredBulk(part);
+    }
+    bulkSendSucceeded();
+}
+
+void NukiNetwork::bulkSendFailed()
+{
+    // count the pending report once, not every retry
+    if (_harBulkRetryDelay == 0)
+    {
+        _harFailed++;
+        _harBulkRetryDelay = HAR_BULK_RETRY_MIN;
+    }
+    else
+    {
+        _harBulkRetryDelay = std::min<uint32_t>(_harBulkRetryDelay * 2, HAR_BULK_RETRY_MAX);
+    }
+    _harBulkRetryTs = espMillis() + _harBulkRetryDelay;
+}
+
+void NukiNetwork::bulkSendSucceeded()
+{
+    _harBulkRetryDelay = 0;
+    _harBulkRetryTs = 0;
+}
+
+bool NukiNetwork::sendBulkMessageToHA(const char *message, size_t len)
+{
+    bool success = false;
+
+    xSemaphoreTake(_harClientSemaphore, portMAX_DELAY);
+
+    if (_homeAutomationMode == 0 && _udpClient) // UDP
+    {
+        _udpClient->beginPacket(_homeAutomationAdress.c_str(), _homeAutomationPort);
+        _udpClient->write(reinterpret_cast<const uint8_t *>(message), len);
+        success = _udpClient->endPacket() == 1;
+    }
+    else if (_homeAutomationMode == 1 && _httpClient && !_homeAutomationBulkPath.isEmpty()) // REST, always POST
+    {
+        char url[256];
+        buildHAUrl(_homeAutomationBulkPath.c_str(), url, sizeof(url));
+        success = requestHA(url, "application/json", message);
     }
+
+    xSemaphoreGive(_harClientSemaphore);
+    return success;
+}
+
+void NukiNetwork::removeDeliveredBulk(JsonDocument &sent)
+{
+    // values changed while sending stay pending
+    xSemaphoreTake(_harBulkSemaphore, portMAX_DELAY);
+    for (JsonPair category : sent.as<JsonObject>())
+    {
+        JsonObject pending = _harBulkDoc[category.key()].as<JsonObject>();
+        if (pending.isNull())
+            continue;
+
+        for (JsonPair field : category.value().as<JsonObject>())
+        {
+            if (pending[field.key()] == field.value())
+                pending.remove(field.key());
+        }
+        if (pending.size() == 0)
+            _harBulkDoc.remove(category.key());
+    }
+    xSemaphoreGive(_harBulkSemaphore);
 }
 
 void NukiNetwork::sendResponse(JsonDocument &jsonResult, bool success, int httpCode)
@@ -862,6 +1187,135 @@ void NukiNetwork::sendResponse(const char *jsonResultStr)
     _server->send(200, F("application/json"), jsonResultStr);
 }
 
+void NukiNetwork::sendStats()
+{
+    JsonDocument json;
+    _restLatency.toJson(json[F("restApi")].to<JsonObject>());
+
+    JsonObject har = json[F("har")].to<JsonObject>();
+    har[F("queued")] = _harQueue.size();
+    har[F("pushed")] = _harQueue.pushedCount();
+    har[F("coalesced")] = _harQueue.coalescedCount();
+    har[F("dropped")] = _harQueue.droppedCount();
+    har[F("sent")] = _harSent;
+    har[F("failed")] = _harFailed;
+    har[F("jsonSent")] = _harBulkSent;
+    har[F("keepAlive")] = _homeAutomationKeepAlive;
+    har[F("newConnections")] = _harNewConnections;
+    har[F("reusedConnections")] = _harReusedConnections;
+    har[F("reconnects")] = _harReconnects;
+
+    JsonObject log = json[F("log")].to<JsonObject>();
+    log[F("written")] = Log->writtenLines();
+    log[F("dropped")] = Log->droppedLines();
+    log[F("queueHighWater")] = Log->queueHighWater();
+    log[F("backups")] = Log->backupCount();
+    log[F("backupFailures")] = Log->backupFailures();
+
+    if (_lockActionQueue != nullptr)
+    {
+        _lockActionQueue->statsToJson(json[F("lockActions")].to<JsonObject>());
+    }
+
+    JsonObject events = json[F("events")].to<JsonObject>();
+    events[F("clients")] = _eventStream.clientCount();
+    events[F("dropped")] = _eventStream.droppedCount();
+
+    sendResponse(json);
+}
+
+void NukiNetwork::sendLockSnapshot(WebServer &server, uint8_t queryCommand)
+{
+    JsonDocument json;
+    int64_t ts = 0;
+
+    if (_lockSnapshotRequestedCallback != nullptr)
+    {
+        ts = _lockSnapshotRequestedCallback(queryCommand, json);
+    }
+
+    int64_t age = ts > 0 ? espMillis() - ts : -1;
+    json[F("age")] = age;
+
+    // refresh only if the caller considers the cached data too old
+    if (age < 0 || (server.hasArg("maxAge") && age > server.arg("maxAge").toInt()))
+    {
+        _queryCommands = _queryCommands | queryCommand;
+        json[F("refreshing")] = 1;
+    }
+
+    if (ts <= 0)
+    {
+        json[F("result")] = "no data";
+        sendResponse(json, false, 503);
+        return;
+    }
+    sendResponse(json);
+}
+
+void NukiNetwork::sendLockActionStatus(uint32_t requestId, uint32_t waitMs, bool accepted)
+{
+    JsonDocument json;
+    LockActionRequest request;
+
+    if (_lockActionQueue == nullptr || !_lockActionQueue->find(requestId, request, waitMs))
+    {
+        json[F("result")] = "unknown_request";
+        sendResponse(json, false, 404);
+        return;
+    }
+
+    char str[20];
+    json[F("requestId")] = request.id;
+    NukiLock::lockactionToString(request.action, str);
+    json[F("action")] = str;
+
+    switch (request.state)
+    {
+    case LockActionState::Queued:
+        json[F("state")] = "queued";
+        break;
+    case LockActionState::Running:
+        json[F("state")] = "running";
+        break;
+    case LockActionState::Done:
+        json[F("state")] = "done";
+        break;
+    default:
+        json[F("state")] = "failed";
+        break;
+    }
+
+    if (request.dispatchedTs > 0)
+    {
+        json[F("queuedMs")] = request.dispatchedTs - request.enqueuedTs;
+    }
+    if (request.completedTs > 0)
+    {
+        NukiLock::cmdResultToString(request.result, str);
+        json[F("cmdResult")] = str;
+        json[F("runMs")] = request.completedTs - request.dispatchedTs;
+        json[F("totalMs")] = request.completedTs - request.enqueuedTs;
+    }
+    else
+    {
+        json[F("ageMs")] = espMillis() - request.enqueuedTs;
+    }
+
+    if (request.state == LockActionState::Failed)
+    {
+        json[F("result")] = "failed";
+        sendResponse(json, false, 502);
+        return;
+    }
+    sendResponse(json, true, accepted && request.state != LockActionState::Done ? 202 : 200);
+}
+
+void NukiNetwork::setLockActionQueue(LockActionQueue *lockActionQueue)
+{
+    _lockActionQueue = lockActionQueue;
+}
+
 void NukiNetwork::readSettings()
 {
     _restartOnDisconnect = _preferences->getBool(preference_restart_on_disconnect, false);
@@ -881,6 +1335,8 @@ void NukiNetwork::readSettings()
         _preferences->putInt(preference_network_timeout, _networkTimeout);
     }
     _sendDebugInfo = _preferences->getBool(preference_send_debug_info, false);
+
+    loadHARFields();
 }
 
 // -----------------------------------------------------------------------------
@@ -987,23 +1443,68 @@ void NukiNetwork::startNetworkServices()
     {
         Log->println(F("[INFO] start Home Automation Report Service"));
 
+        xSemaphoreTake(_harClientSemaphore, portMAX_DELAY);
         if (_homeAutomationMode == 1 && _httpClient == nullptr) // REST
-            _httpClient = new HTTPClient();
+            _httpClient = createHttpClient();
         else if (_homeAutomationMode == 0 && _udpClient == nullptr) // UDP
             _udpClient = new NetworkUDP();
+        xSemaphoreGive(_harClientSemaphore);
+
+        if (_harSenderTaskHandle == nullptr)
+        {
+            if (xTaskCreatePinnedToCore(harSenderTask, "harSend", HAR_SENDER_TASK_SIZE, this, 1, &_harSenderTaskHandle, xPortGetCoreID()) != pdPASS)
+            {
+                Log->println(F("[ERROR] Home Automation sender task could not be started!"));
+                _harSenderTaskHandle = nullptr;
+            }
+        }
     }
 
     if (_apiEnabled)
     {
         Log->println(F("[INFO] start REST API Server"));
-        _server = new WebServer(_apiPort);
-        if (_server)
+        xSemaphoreTake(_serverSemaphore, portMAX_DELAY);
+        startRestServer();
+        xSemaphoreGive(_serverSemaphore);
+    }
+}
+
+void NukiNetwork::startRestServer()
+{
+    _server = new WebServer(_apiPort);
+    if (_server)
+    {
+        _server->onNotFound([this]()
+                            { onRestDataReceivedCallback(this->_server->uri().c_str(), *this->_server); });
+        _server->begin();
+    }
+}
+
+void NukiNetwork::handleClient()
+{
+    if (!_apiEnabled || _server == nullptr)
+    {
+        return;
+    }
+
+    if (xSemaphoreTake(_serverSemaphore, 0) != pdTRUE)
+    {
+        return; // server is being restarted
+    }
+
+    if (_server)
+    {
+        int64_t startUs = esp_timer_get_time();
+        _restRequestHandled = false;
+        _server->handleClient();
+        if (_restRequestHandled)
         {
-            _server->onNotFound([this]()
-                                { onRestDataReceivedCallback(this->_server->uri().c_str(), *this->_server); });
-            _server->begin();
+            _restLatency.add(esp_timer_get_time() - startUs);
         }
+        _eventStream.loop();
     }
+
+    xSemaphoreGive(_serverSemaphore);
 }
 
 void NukiNetwork::onRestDataReceivedCallback(const char *path, WebServer &server)
@@ -1011,6 +1512,8 @@ void NukiNetwork::onRestDataReceivedCallback(const char *path, WebServer &server
 
     if (_inst)
     {
+        _inst->_restRequestHandled = true;
+
         if (!_inst->_apiEnabled)
             return;
 
@@ -1091,6 +1594,10 @@ void NukiNetwork::onRestDataReceived(const char *path, WebServer &server)
         _preferences->putBool(preference_api_enabled, _apiEnabled);
         sendResponse(json);
     }
+    else if (comparePrefixedPath(path, api_path_bridge_stats))
+    {
+        sendStats();
+    }
     else if (comparePrefixedPath(path, api_path_bridge_reboot))
     {
         Log->println(F("[INFO] (REST API) Reboot requested"));
@@ -1138,29 +1645,54 @@ void NukiNetwork::onRestDataReceived(const char *path, WebServer &server)
     }
     else if (_lockEnabled)
     {
+        if (comparePrefixedPath(path, api_path_lock_state))
+        {
+            sendLockSnapshot(server, QUERY_COMMAND_LOCKSTATE);
+            return;
+        }
+        if (comparePrefixedPath(path, api_path_lock_battery))
+        {
+            sendLockSnapshot(server, QUERY_COMMAND_BATTERY);
+            return;
+        }
+        if (comparePrefixedPath(path, api_path_lock_config))
+        {
+            sendLockSnapshot(server, QUERY_COMMAND_CONFIG);
+            return;
+        }
+        if (comparePrefixedPath(path, api_path_lock_events))
+        {
+            acceptEventStream(server);
+            return;
+        }
+
         if (comparePrefixedPath(path, api_path_lock_action))
         {
+            // the token is an argument as well, so read the action by name if given
+            String action = server.hasArg("val") ? server.arg("val") : String(data);
+            uint32_t waitMs = server.hasArg("wait") ? std::min((uint32_t)server.arg("wait").toInt(), (uint32_t)LOCK_ACTION_MAX_WAIT) : 0;
 
-            if (!data || !*data)
+            if (action.length() == 0)
             {
                 json[F("result")] = "missing data";
                 sendResponse(json, false, 400);
+                return;
             }
-            return;
 
             Log->println(F("[INFO] (REST API) Lock action received: "));
-            Log->printf(F("[INFO] %s\n"), data);
+            Log->printf(F("[INFO] %s\n"), action.c_str());
 
             LockActionResult lockActionResult = LockActionResult::Failed;
+            uint32_t requestId = 0;
             if (_lockActionReceivedCallback != NULL)
             {
-                lockActionResult = _lockActionReceivedCallback(data);
+                lockActionResult = _lockActionReceivedCallback(action.c_str(), requestId);
             }
 
             switch (lockActionResult)
             {
             case LockActionResult::Success:
-                sendResponse(json);
+                sendLockActionStatus(requestId, waitMs, true);
                 break;
             case LockActionResult::UnknownAction:
                 json[F("result")] = "unknown_action";
@@ -1170,6 +1702,10 @@ void NukiNetwork::onRestDataReceived(const char *path, WebServer &server)
                 json[F("result")] = "denied";
                 sendResponse(json, false, 403);
                 break;
+            case LockActionResult::QueueFull:
+                json[F("result")] = "queue_full";
+                sendResponse(json, false, 503);
+                break;
             case LockActionResult::Failed:
                 json[F("result")] = "error";
                 sendResponse(json, false, 500);
@@ -1178,6 +1714,21 @@ void NukiNetwork::onRestDataReceived(const char *path, WebServer &server)
             return;
         }
 
+        if (comparePrefixedPath(path, api_path_lock_action_status))
+        {
+            uint32_t waitMs = server.hasArg("wait") ? std::min((uint32_t)server.arg("wait").toInt(), (uint32_t)LOCK_ACTION_MAX_WAIT) : 0;
+
+            if (!server.hasArg("id"))
+            {
+                json[F("result")] = "missing data";
+                sendResponse(json, false, 400);
+                return;
+            }
+
+            sendLockActionStatus(server.arg("id").toInt(), waitMs, false);
+            return;
+        }
+
         if (comparePrefixedPath(path, api_path_keypad_command_action))
         {
             if (_keypadCommandReceivedReceivedCallback != nullptr)
@@ -1312,6 +1863,126 @@ void NukiNetwork::onShutdownReceived(const char *path, WebServer &server)
     safeShutdownESP(RestartReason::SafeShutdownRequestViaApi);
 }
 
+bool NukiNetwork::superviseNetworkServices(int64_t ts)
+{
+    switch (_serviceCheckStep)
+    {
+    case ServiceCheckStep::Idle:
+        if (ts - _lastNetworkServiceTs > NETWORK_SERVICE_CHECK_INTERVAL)
+        { // test all 30 seconds
+            _lastNetworkServiceTs = ts;
+            if (startServiceProbe(ts))
+            {
+                _serviceCheckStep = ServiceCheckStep::Probe;
+            }
+        }
+        break;
+
+    case ServiceCheckStep::Probe:
+    case ServiceCheckStep::Recheck:
+    {
+        NetworkServiceState result;
+        if (!pollServiceProbe(ts, result))
+        {
+            break; // probe still running
+        }
+
+        _networkServicesState = result;
+
+        if (result == NetworkServiceState::OK)
+        {
+            _networkServicesConnectCounter = 0;
+            _serviceCheckStep = ServiceCheckStep::Idle;
+        }
+        else if (_serviceCheckStep == ServiceCheckStep::Probe)
+        { // error in network Services
+            _serviceCheckStep = ServiceCheckStep::Restart;
+        }
+        else
+        {
+            _networkServicesConnectCounter++;
+            _serviceCheckStep = ServiceCheckStep::Idle;
+            return false;
+        }
+        break;
+    }
+
+    case ServiceCheckStep::Restart:
+        // a timed out probe still uses the HA client and the server, don't tear them down under it
+        if (_serviceProbeBusy.load())
+        {
+            break;
+        }
+        restartNetworkServices(_networkServicesState);
+        _serviceCheckTs = ts;
+        _serviceCheckStep = ServiceCheckStep::Settle;
+        break;
+
+    case ServiceCheckStep::Settle:
+        // give the restarted services some time before testing them again
+        if (ts - _serviceCheckTs >= NETWORK_SERVICE_SETTLE_TIME && startServiceProbe(ts))
+        {
+            _serviceCheckStep = ServiceCheckStep::Recheck;
+        }
+        break;
+    }
+
+    return true;
+}
+
+bool NukiNetwork::startServiceProbe(int64_t ts)
+{
+    if (_serviceProbeBusy.load())
+    {
+        return false;
+    }
+
+    if (_serviceProbeTaskHandle == nullptr)
+    {
+        if (xTaskCreatePinnedToCore(serviceProbeTask, "svcProbe", NETWORK_SERVICE_PROBE_TASK_SIZE, this, 1, &_serviceProbeTaskHandle, xPortGetCoreID()) != pdPASS)
+        {
+            Log->println(F("[ERROR] Network service probe task could not be started!"));
+            _serviceProbeTaskHandle = nullptr;
+            return false;
+        }
+    }
+
+    _serviceProbeBusy.store(true);
+    _serviceCheckTs = ts;
+    xTaskNotifyGive(_serviceProbeTaskHandle);
+    return true;
+}
+
+bool NukiNetwork::pollServiceProbe(int64_t ts, NetworkServiceState &result)
+{
+    if (!_serviceProbeBusy.load())
+    {
+        result = (NetworkServiceState)_serviceProbeResult.load();
+        return true;
+    }
+
+    if (ts - _serviceCheckTs > NETWORK_SERVICE_PROBE_TIMEOUT)
+    {
+        Log->println(F("[WARNING] Network service probe timed out"));
+        result = NetworkServiceState::ERROR_BOTH;
+        return true;
+    }
+
+    return false;
+}
+
+void NukiNetwork::serviceProbeTask(void *parameter)
+{
+    NukiNetwork *network = static_cast<NukiNetwork *>(parameter);
+
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        network->_serviceProbeResult.store((int8_t)network->testNetworkServices());
+        network->_serviceProbeBusy.store(false);
+    }
+}
+
 NetworkServiceState NukiNetwork::testNetworkServices()
 {
     bool haClientOk = true;
@@ -1331,7 +2002,7 @@ NetworkServiceState NukiNetwork::testNetworkServices()
             // 2. ping test for _homeAutomationAdress
             if (!_homeAutomationAdress.isEmpty() && haClientOk)
             {
-                if (!Ping.ping(_homeAutomationAdress.c_str()))
+                if (!Ping.ping(_homeAutomationAdress.c_str(), 1))
                 {
                     Log->println(F("[ERROR] Ping to Home Automation Server failed!"));
                     haClientOk = false;
@@ -1343,13 +2014,17 @@ NetworkServiceState NukiNetwork::testNetworkServices()
             }
 
             // 3. if Home Automation state API path exists, execute GET request
-            String strPath = _preferences->getString(preference_har_key_state, "");
+            xSemaphoreTake(_harFieldsSemaphore, portMAX_DELAY);
+            String strPath = _harFields[(uint8_t)HarField::State].key;
+            xSemaphoreGive(_harFieldsSemaphore);
             if (!strPath.isEmpty() && haClientOk)
             {
                 String url = "http://" + _homeAutomationAdress + ":" + String(_homeAutomationPort) + "/" + strPath;
                 Log->println("[DEBUG] Performing GET request to: " + url);
 
                 HTTPClient http;
+                http.setConnectTimeout(NETWORK_SERVICE_REQUEST_TIMEOUT);
+                http.setTimeout(NETWORK_SERVICE_REQUEST_TIMEOUT);
                 http.begin(url);
                 int httpCode = http.GET();
                 http.end();
@@ -1375,7 +2050,7 @@ NetworkServiceState NukiNetwork::testNetworkServices()
 
             if (!_homeAutomationAdress.isEmpty())
             {
-                if (!Ping.ping(_homeAutomationAdress.c_str()))
+                if (!Ping.ping(_homeAutomationAdress.c_str(), 1))
                 {
                     Log->println(F("[ERROR] Ping to UDP Home Automation Server failed!"));
                     haClientOk = false;
@@ -1399,7 +2074,7 @@ NetworkServiceState NukiNetwork::testNetworkServices()
 
         // 5. test whether the local REST web server can be reached on the port
         WiFiClient client;
-        if (!client.connect(WiFi.localIP(), _apiPort))
+        if (!client.connect(WiFi.localIP(), _apiPort, NETWORK_SERVICE_REQUEST_TIMEOUT))
         {
             Log->println(F("[ERROR] WebServer is not responding!"));
             apiServerOk = false;
@@ -1442,6 +2117,7 @@ void NukiNetwork::restartNetworkServices(NetworkServiceState status)
         if (status == NetworkServiceState::ERROR_HAR_CLIENT || status == NetworkServiceState::ERROR_BOTH)
         {
             Log->println(F("[INFO] Reinitialization of HTTP client..."));
+            xSemaphoreTake(_harClientSemaphore, portMAX_DELAY);
             // Clean up depending on the mode
             if (_homeAutomationMode == 1 && _httpClient)
             {
@@ -1458,7 +2134,7 @@ void NukiNetwork::restartNetworkServices(NetworkServiceState status)
             // Reinitialize
             if (_homeAutomationMode == 1)
             {
-                _httpClient = new HTTPClient();
+                _httpClient = createHttpClient();
                 if (_httpClient)
                     Log->println(F("[INFO] HTTP client successfully reinitialized."));
                 else
@@ -1472,6 +2148,7 @@ void NukiNetwork::restartNetworkServices(NetworkServiceState status)
                 else
                     Log->println(F("[ERROR] Failed to reinitialize UDP client."));
             }
+            xSemaphoreGive(_harClientSemaphore);
         }
     }
     // If the REST web server cannot be reached (-1 or -3), restart it
@@ -1480,18 +2157,17 @@ void NukiNetwork::restartNetworkServices(NetworkServiceState status)
         if (status == NetworkServiceState::ERROR_REST_API_SERVER || status == NetworkServiceState::ERROR_BOTH)
         {
             Log->println(F("[INFO] Restarting the REST WebServer..."));
+            xSemaphoreTake(_serverSemaphore, portMAX_DELAY);
             if (_server)
             {
                 _server->stop();
                 delete _server;
                 _server = nullptr;
             }
-            _server = new WebServer(_apiPort);
+            startRestServer();
+            xSemaphoreGive(_serverSemaphore);
             if (_server)
             {
-                _server->onNotFound([this]()
-                                    { onRestDataReceivedCallback(this->_server->uri().c_str(), *this->_server); });
-                _server->begin();
                 Log->println(F("[INFO] REST WebServer successfully restarted."));
             }
             else
@@ -12,6 +12,7 @@
 #include "ESP32Ping.h"
 #include <esp_mac.h>
 #include <ArduinoJson.h>
+#include <atomic>
 
 #include "NukiConstants.h"
 #include "NukiLockConstants.h"
@@ -22,6 +23,11 @@
 #include "NetworkServiceState.h"
 #include "QueryCommand.h"
 #include "LockActionResult.h"
+#include "LockActionQueue.h"
+#include "LatencyHistogram.hpp"
+#include "HomeAutomationReportQueue.h"
+#include "HomeAutomationFields.h"
+#include "EventStream.hpp"
 
 /**
  * @brief Manages network interfaces (Wi-Fi, Ethernet), REST API, and Home Automation communication.
@@ -65,6 +71,14 @@ public:
      */
     bool update();
 
+    /**
+     * @brief Processes pending REST API requests.
+     *
+     * Called periodically from the dedicated REST API task. Each handled request
+     * is timed and recorded in the REST latency histogram.
+     */
+    void handleClient();
+
     /**
      * @brief Performs a new configuration / reconnect (e.g. with a new SSID).
      */
@@ -145,12 +159,51 @@ public:
      */
     void sendToHAKeyTurnerState(const NukiLock::KeyTurnerState &keyTurnerState, const NukiLock::KeyTurnerState &lastKeyTurnerState);
 
+    /**
+     * @brief Adds the changed key turner state fields to the pending JSON bulk report.
+     * @param keyTurnerState Current key turner state.
+     * @param lastKeyTurnerState Previously known key turner state.
+     */
+    void sendToHAKeyTurnerStateBulk(const NukiLock::KeyTurnerState &keyTurnerState, const NukiLock::KeyTurnerState &lastKeyTurnerState);
+
     /**
      * @brief Sends the battery report to the Home Automation system.
      * @param batteryReport Struct containing battery data.
      */
     void sendToHABatteryReport(const NukiLock::BatteryReport &batteryReport);
 
+    /**
+     * @brief Pushes the changed key turner state fields to the event stream clients.
+     * @param keyTurnerState Current key turner state.
+     * @param lastKeyTurnerState Previously known key turner state.
+     */
+    void streamKeyTurnerState(const NukiLock::KeyTurnerState &keyTurnerState, const NukiLock::KeyTurnerState &lastKeyTurnerState);
+
+    /**
+     * @brief Pushes the changed battery report fields to the event stream clients.
+     * @param batteryReport Current battery report.
+     * @param lastBatteryReport Previously known battery report.
+     */
+    void streamBatteryReport(const NukiLock::BatteryReport &batteryReport, const NukiLock::BatteryReport &lastBatteryReport);
+
+    /**
+     * @brief Writes key turner state fields as JSON (used by bulk reports, snapshots and the event stream).
+     * @param json Target object.
+     * @param keyTurnerState Current key turner state.
+     * @param lastKeyTurnerState Previously known key turner state.
+     * @param all Write all fields instead of only the changed ones.
+     */
+    static void keyTurnerStateToJson(JsonObject json, const NukiLock::KeyTurnerState &keyTurnerState, const NukiLock::KeyTurnerState &lastKeyTurnerState, bool all);
+
+    /**
+     * @brief Writes battery report fields as JSON (used by bulk reports, snapshots and the event stream).
+     * @param json Target object.
+     * @param batteryReport Current battery report.
+     * @param lastBatteryReport Previously known battery report.
+     * @param all Write all fields instead of only the changed ones.
+     */
+    static void batteryReportToJson(JsonObject json, const NukiLock::BatteryReport &batteryReport, const NukiLock::BatteryReport &lastBatteryReport, bool all);
+
     /**
      * @brief Sends the BLE RSSI value to the Home Automation system.
      * @param rssi Received signal strength indicator (RSSI).
@@ -233,7 +286,9 @@ public:
     uint8_t queryCommands();
 
     /**
-     * @brief Sends arbitrary requests to Home Automation (e.g. to provide status values).
+     * @brief Queues arbitrary requests to Home Automation (e.g. to provide status values).
+     *
+     * The report is sent asynchronously by the HAR sender task, the caller never waits for the HA server.
      */
     void sendDataToHA(const char *key, const char *param, const char *value);
 
@@ -252,9 +307,22 @@ public:
 
     /**
      * @brief Sets the callback for lock action requests.
-     * @param lockActionReceivedCallback Function pointer to lock action handler.
+     * @param lockActionReceivedCallback Function pointer to lock action handler, sets the id of the queued request.
      */
-    void setLockActionReceivedCallback(LockActionResult (*lockActionReceivedCallback)(const char *value));
+    void setLockActionReceivedCallback(LockActionResult (*lockActionReceivedCallback)(const char *value, uint32_t &requestId));
+
+    /**
+     * @brief Sets the queue of lock actions, used to report the progress of a request.
+     * @param lockActionQueue Queue owned by the lock.
+     */
+    void setLockActionQueue(LockActionQueue *lockActionQueue);
+
+    /**
+     * @brief Sets the callback that fills cached lock data into REST snapshot responses.
+     * @param lockSnapshotRequestedCallback Function pointer taking the QUERY_COMMAND_* of the requested data,
+     *        returns the espMillis() timestamp of the data or 0 if nothing is cached.
+     */
+    void setLockSnapshotRequestedCallback(int64_t (*lockSnapshotRequestedCallback)(uint8_t queryCommand, JsonDocument &json));
 
     /**
      * @brief Sets the callback for time control command requests.
@@ -316,6 +384,111 @@ private:
      */
     void onRestDataReceived(const char *path, WebServer &server);
 
+    /**
+     * @brief Answers the bridge stats request with the REST latency histogram.
+     */
+    void sendStats();
+
+    /**
+     * @brief Creates and starts the REST API WebServer.
+     */
+    void startRestServer();
+
+    /**
+     * @brief Creates the HTTP client for REST reporting (keep-alive and timeouts applied).
+     * @return The new client.
+     */
+    HTTPClient *createHttpClient();
+
+    /**
+     * @brief Loads the key / param of all HAR fields from preferences into RAM.
+     *        Called from readSettings(), i.e. again whenever the web configuration is saved.
+     */
+    void loadHARFields();
+
+    /**
+     * @brief Queues a value for a HAR field using its cached key / param.
+     * @param field The HAR field.
+     * @param value Value as string.
+     */
+    void sendDataToHA(HarField field, const char *value);
+
+    // Typed variants of the public sendToHA* methods for cached HAR fields
+    void sendToHAFloat(HarField field, const float value, const uint8_t precision = 2);
+    void sendToHAInt(HarField field, const int value);
+    void sendToHAUInt(HarField field, const unsigned int value);
+    void sendToHAULong(HarField field, const unsigned long value);
+    void sendToHAString(HarField field, const char *value);
+
+    /**
+     * @brief Wakes up the HAR sender task.
+     */
+    void notifyHARSender();
+
+    /**
+     * @brief Builds the URL for a request to Home Automation (credentials, host, port and path).
+     * @param path Path below the HA server root.
+     * @param url Output buffer.
+     * @param size Size of the output buffer.
+     */
+    void buildHAUrl(const char *path, char *url, size_t size);
+
+    /**
+     * @brief Performs a single HTTP request to Home Automation, re-establishing a closed kept-alive connection.
+     *        _harClientSemaphore must be held by the caller.
+     * @param url Full request URL.
+     * @param contentType Content type header.
+     * @param postData Request body, nullptr for GET.
+     * @return true if the server answered with a status code below 400.
+     */
+    bool requestHA(const char *url, const char *contentType, const char *postData);
+
+    /**
+     * @brief Sends the pending JSON bulk report (if any) in one POST request or UDP datagram.
+     *
+     * A report larger than HAR_BULK_MAX_SIZE is split into one report per category. The
+     * pending changes are only removed once they have been delivered, a failed report is
+     * sent again after a delay that doubles with each failure (HAR_BULK_RETRY_MIN .. HAR_BULK_RETRY_MAX).
+     */
+    void transmitBulkToHA();
+
+    /**
+     * @brief Sends one serialized JSON bulk report (UDP or REST POST). Blocks until done.
+     * @param message Serialized report.
+     * @param len Length of message.
+     * @return true if the report was delivered.
+     */
+    bool sendBulkMessageToHA(const char *message, size_t len);
+
+    /**
+     * @brief Counts a failed JSON bulk report (once per report) and doubles the retry delay.
+     */
+    void bulkSendFailed();
+
+    /**
+     * @brief Resets the JSON bulk report retry delay after a delivery.
+     */
+    void bulkSendSucceeded();
+
+    /**
+     * @brief Removes delivered fields from the pending JSON bulk report.
+     * @param sent Categories and fields that have been sent, fields changed in the meantime are kept.
+     */
+    void removeDeliveredBulk(JsonDocument &sent);
+
+    /**
+     * @brief Sends a single queued report to Home Automation (UDP or REST). Blocks until done.
+     * @param report The report to send.
+     * @return true if the report was delivered.
+     */
+    bool transmitToHA(const HomeAutomationReport &report);
+
+    /**
+     * @brief Task entry point that drains the Home Automation report queue.
+     * @param parameter Pointer to the NukiNetwork instance.
+     */
+    static void harSenderTask(void *parameter);
+
     /**
      * @brief Handles logic for shutdown REST request.
      * @param path Full request URI path.
@@ -323,6 +496,37 @@ private:
      */
     void onShutdownReceived(const char *path, WebServer &server);
 
+    /**
+     * @brief Steps through network service supervision (probe, restart, settle, re-probe).
+     *
+     * Advances at most one step per call and never waits for a probe to finish.
+     *
+     * @param ts Current timestamp in ms.
+     * @return false if the services are still faulty after a restart, otherwise true.
+     */
+    bool superviseNetworkServices(int64_t ts);
+
+    /**
+     * @brief Hands a service test to the probe task.
+     * @param ts Current timestamp in ms.
+     * @return true if the probe was started, false if a previous probe is still running.
+     */
+    bool startServiceProbe(int64_t ts);
+
+    /**
+     * @brief Checks whether the running service probe has finished or timed out.
+     * @param ts Current timestamp in ms.
+     * @param result Receives the probe result if finished.
+     * @return true if a result is available.
+     */
+    bool pollServiceProbe(int64_t ts, NetworkServiceState &result);
+
+    /**
+     * @brief Task entry point that runs testNetworkServices() on request.
+     * @param parameter Pointer to the NukiNetwork instance.
+     */
+    static void serviceProbeTask(void *parameter);
+
     /**
      * @brief Runs tests for WebServer (API) and HTTPClient (HAR) (e.g., ping).
      */
@@ -366,6 +570,30 @@ private:
      */
     bool comparePrefixedPath(const char *fullPath, const char *subPath);
 
+    /**
+     * @brief Answers a snapshot request from the cached lock data.
+     *
+     * Adds the age of the data in ms. A refresh over BLE is only queued if nothing is
+     * cached or the optional "maxAge" argument (ms) is exceeded.
+     * @param server WebServer instance holding the request arguments.
+     * @param queryCommand QUERY_COMMAND_* of the requested data.
+     */
+    void sendLockSnapshot(WebServer &server, uint8_t queryCommand);
+
+    /**
+     * @brief Takes over the request as event stream client, answers 503 if the client limit is reached.
+     * @param server WebServer instance handling the request.
+     */
+    void acceptEventStream(WebServer &server);
+
+    /**
+     * @brief Answers with the progress of a lock action request.
+     * @param requestId Request id returned when the action was queued.
+     * @param waitMs Max. time to wait for the action to finish.
+     * @param accepted Whether the request was just queued (HTTP 202 while it is not finished yet).
+     */
+    void sendLockActionStatus(uint32_t requestId, uint32_t waitMs, bool accepted);
+
     /**
      * @brief Combines bridge path with the subpath.
      * @param path Path to append.
@@ -380,6 +608,18 @@ private:
      */
     char *getArgs(WebServer &server);
 
+    /**
+     * @brief Steps of the non-blocking network service supervision.
+     */
+    enum class ServiceCheckStep : uint8_t
+    {
+        Idle,    // waiting for the next check interval
+        Probe,   // first probe running
+        Restart, // probe failed, restart services once no probe is running anymore
+        Settle,  // waiting before re-probing
+        Recheck  // re-probe after restart running
+    };
+
     // Singleton instance
     static NukiNetwork *_inst;
 
@@ -404,6 +644,11 @@ private:
     bool _restartOnDisconnect = false;                                        // Whether the device should reboot on disconnect
     bool _firstTunerStateSent = true;                                         // Ensures the first lock state is always sent
     NetworkServiceState _networkServicesState = NetworkServiceState::UNKNOWN; // Current state of network services
+    ServiceCheckStep _serviceCheckStep = ServiceCheckStep::Idle;              // Current supervision step
+    int64_t _serviceCheckTs = 0;                                              // Start time of the current supervision step
+    TaskHandle_t _serviceProbeTaskHandle = nullptr;                           // Task running the (blocking) service probes
+    std::atomic<bool> _serviceProbeBusy{false};                               // True while a probe is running
+    std::atomic<int8_t> _serviceProbeResult{1};                               // Result of the last finished probe (NetworkServiceState)
                                                                               //
     String _keypadCommandName = "";                                           // Temporary buffer for keypad command name
     String _keypadCommandCode = "";                                           // Temporary buffer for keypad command code
@@ -419,8 +664,29 @@ private:
     int64_t _lastRssiTs = 0;                                                  // Last time RSSI was transmitted
                                                                               //
     WebServer *_server = nullptr;                                             // REST API web server instance
+    SemaphoreHandle_t _serverSemaphore = xSemaphoreCreateMutex();             // Guards _server against restarts while a request is handled
+    LatencyHistogram _restLatency;                                            // Request-to-response latency of the REST API
+    bool _restRequestHandled = false;                                         // Set by the request callback during handleClient()
     HTTPClient *_httpClient = nullptr;                                        // HTTP client for sending Data to HA
     NetworkUDP *_udpClient = nullptr;                                         // UDP client for sending Data to HA
+    SemaphoreHandle_t _harClientSemaphore = xSemaphoreCreateMutex();          // Guards _httpClient / _udpClient against restarts while sending
+    HarFieldConfig _harFields[(uint8_t)HarField::Count] = {};                 // Cached key / param of all HAR fields
+    SemaphoreHandle_t _harFieldsSemaphore = xSemaphoreCreateMutex();          // Guards _harFields against reloads
+    HomeAutomationReportQueue _harQueue;                                      // Pending reports to Home Automation
+    TaskHandle_t _harSenderTaskHandle = nullptr;                              // Task sending the queued reports
+    volatile uint32_t _harSent = 0;                                           // Number of delivered reports
+    volatile uint32_t _harFailed = 0;                                         // Number of reports that could not be delivered
+    JsonDocument _harBulkDoc;                                                 // Pending JSON bulk report, grouped by HAR category
+    SemaphoreHandle_t _harBulkSemaphore = xSemaphoreCreateMutex();            // Guards _harBulkDoc
+    bool _harBulkPathWarned = false;                                          // The missing JSON report path has been logged
+    uint32_t _harBulkRetryDelay = 0;                                          // Current JSON report retry delay (ms), 0 after a delivery, sender task only
+    int64_t _harBulkRetryTs = 0;                                              // No JSON report is sent before this time, sender task only
+    EventStream _eventStream;                                                 // text/event-stream clients of the REST API
+    LockActionQueue *_lockActionQueue = nullptr;                              // Lock actions requested via API, owned by NukiWrapper
+    volatile uint32_t _harBulkSent = 0;                                       // Number of delivered JSON bulk reports
+    volatile uint32_t _harNewConnections = 0;                                 // REST reports that needed a new TCP connection
+    volatile uint32_t _harReusedConnections = 0;                              // REST reports sent over a kept-alive connection
+    volatile uint32_t _harReconnects = 0;                                     // Kept-alive connections found closed and re-established
     int _foundNetworks = 0;                                                   // Number of WiFi networks found during last scan
     int _networkTimeout = 0;                                                  // Timeout in ms for network operations
     int _rssiSendInterval = 0;                                                // Interval for RSSI reporting
@@ -436,6 +702,9 @@ private:
     String _homeAutomationPassword;                                           // Optional HA password
     int _homeAutomationMode;                                                  // current Mode for data reporting to Ha (0=UDP/1=REST)
     int _homeAutomationRestMode;                                              // Rest Mode (0=GET/1=POST)
+    bool _homeAutomationKeepAlive = true;                                     // Reuse the TCP connection for REST reports
+    bool _homeAutomationBulk = false;                                         // Send key turner state and battery report as one JSON document
+    String _homeAutomationBulkPath;                                           // REST path the JSON bulk report is POSTed to
     int _homeAutomationPort;                                                  // Port for HA
                                                                               //
     char *_buffer;                                                            // Shared buffer for response generation
@@ -445,7 +714,8 @@ private:
     int _apiPort;                                                             // REST API server port
 
     // Callback handlers
-    LockActionResult (*_lockActionReceivedCallback)(const char *value) = nullptr;                                                                              // Lock command handler
+    LockActionResult (*_lockActionReceivedCallback)(const char *value, uint32_t &requestId) = nullptr;                                                         // Lock command handler
+    int64_t (*_lockSnapshotRequestedCallback)(uint8_t queryCommand, JsonDocument &json) = nullptr;                                                             // Cached lock data handler
     void (*_configUpdateReceivedCallback)(const char *value) = nullptr;                                                                                        // Config update handler
     void (*_keypadCommandReceivedReceivedCallback)(const char *command, const uint &id, const String &name, const String &code, const int &enabled) = nullptr; // Keypad handler
     void (*_timeControlCommandReceivedReceivedCallback)(const char *value) = nullptr;                                                                          // Time control handler
@@ -25,18 +25,25 @@ NukiWrapper::NukiWrapper(const std::string &deviceName, NukiDeviceId *deviceId,
     nukiInst = this;
 
     // KeyTurnerState und BatteryReport initialisieren
-    memset(&_lastKeyTurnerState, sizeof(NukiLock::KeyTurnerState), 0);
-    memset(&_lastBatteryReport, sizeof(NukiLock::BatteryReport), 0);
-    memset(&_keyTurnerState, sizeof(NukiLock::KeyTurnerState), 0);
-    memset(&_batteryReport, sizeof(NukiLock::BatteryReport), 0);
+    // value-initialized, the "unknown" defaults of KeyTurnerState must not be zeroed
+    _lastKeyTurnerState = NukiLock::KeyTurnerState();
+    memset(&_lastBatteryReport, 0, sizeof(NukiLock::BatteryReport));
+    _keyTurnerState = NukiLock::KeyTurnerState();
+    memset(&_batteryReport, 0, sizeof(NukiLock::BatteryReport));
     _keyTurnerState.lockState = NukiLock::LockState::Undefined;
+    _snapshotMutex = xSemaphoreCreateMutex();
+    _aclMutex = xSemaphoreCreateMutex();
 
     network->setLockActionReceivedCallback(nukiInst->onLockActionReceivedCallback);
+    network->setLockSnapshotRequestedCallback(nukiInst->onLockSnapshotRequestedCallback);
+    network->setLockActionQueue(&_lockActionQueue);
 }
 
 NukiWrapper::~NukiWrapper()
 {
     _bleScanner = nullptr;
+    vSemaphoreDelete(_snapshotMutex);
+    vSemaphoreDelete(_aclMutex);
 }
 
 void NukiWrapper::initialize()
@@ -139,9 +146,24 @@ void NukiWrapper::readSettings()
     _forceDoorsensor = _preferences->getBool(preference_lock_force_doorsensor, false);
     _forceKeypad = _preferences->getBool(preference_lock_force_keypad, false);
     _forceId = _preferences->getBool(preference_lock_force_id, false);
-
-    _preferences->getBytes(preference_conf_lock_basic_acl, &_basicLockConfigaclPrefs, sizeof(_basicLockConfigaclPrefs));
-    _preferences->getBytes(preference_conf_lock_advanced_acl, &_advancedLockConfigaclPrefs, sizeof(_advancedLockConfigaclPrefs));
+    _updateTime = _preferences->getBool(preference_update_time, false);
+    _authLogMaxEntries = _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG);
+
+    // load into local copies first, the REST API task checks the ACL concurrently
+    uint32_t aclPrefs[sizeof(_aclPrefs) / sizeof(_aclPrefs[0])] = {};
+    uint32_t basicLockConfigAclPrefs[sizeof(_basicLockConfigaclPrefs) / sizeof(_basicLockConfigaclPrefs[0])];
+    uint32_t advancedLockConfigAclPrefs[sizeof(_advancedLockConfigaclPrefs) / sizeof(_advancedLockConfigaclPrefs[0])];
+    memcpy(basicLockConfigAclPrefs, _basicLockConfigaclPrefs, sizeof(basicLockConfigAclPrefs));
+    memcpy(advancedLockConfigAclPrefs, _advancedLockConfigaclPrefs, sizeof(advancedLockConfigAclPrefs));
+    _preferences->getBytes(preference_acl, aclPrefs, sizeof(aclPrefs));
+    _preferences->getBytes(preference_conf_lock_basic_acl, basicLockConfigAclPrefs, sizeof(basicLockConfigAclPrefs));
+    _preferences->getBytes(preference_conf_lock_advanced_acl, advancedLockConfigAclPrefs, sizeof(advancedLockConfigAclPrefs));
+
+    xSemaphoreTake(_aclMutex, portMAX_DELAY);
+    memcpy(_aclPrefs, aclPrefs, sizeof(_aclPrefs));
+    memcpy(_basicLockConfigaclPrefs, basicLockConfigAclPrefs, sizeof(_basicLockConfigaclPrefs));
+    memcpy(_advancedLockConfigaclPrefs, advancedLockConfigAclPrefs, sizeof(_advancedLockConfigaclPrefs));
+    xSemaphoreGive(_aclMutex);
 
     if (_nrOfRetries < 0 || _nrOfRetries == 200)
     {
@@ -238,14 +260,15 @@ void NukiWrapper::update(bool reboot)
 
     _nukiLock.updateConnectionState();
 
-    if (_nextLockAction != (NukiLock::LockAction)0xff)
+    LockActionRequest request;
+    if (_lockActionQueue.next(request))
     {
         int retryCount = 0;
-        Nuki::CmdResult cmdResult;
+        Nuki::CmdResult cmdResult = (Nuki::CmdResult)-1;
 
         while (retryCount < _nrOfRetries + 1 && cmdResult != Nuki::CmdResult::Success)
         {
-            cmdResult = _nukiLock.lockAction(_nextLockAction, 0, 0);
+            cmdResult = _nukiLock.lockAction(request.action, 0, 0);
             char resultStr[15] = {0};
             NukiLock::cmdResultToString(cmdResult, resultStr);
 
@@ -268,10 +291,10 @@ void NukiWrapper::update(bool reboot)
             postponeBleWatchdog();
         }
 
+        _lockActionQueue.complete(request.id, cmdResult);
+
         if (cmdResult == Nuki::CmdResult::Success)
         {
-            _nextLockAction = (NukiLock::LockAction)0xff;
-
             retryCount = 0;
             _statusUpdated = true;
 
@@ -287,7 +310,6 @@ void NukiWrapper::update(bool reboot)
             Log->println(F("[WARNING] Lock: Maximum number of retries exceeded, aborting."));
 
             retryCount = 0;
-            _nextLockAction = (NukiLock::LockAction)0xff;
         }
     }
     if (_statusUpdated || _nextLockStateUpdateTs == 0 || ts >= _nextLockStateUpdateTs || (queryCommands & QUERY_COMMAND_LOCKSTATE) > 0)
@@ -349,7 +371,7 @@ void NukiWrapper::update(bool reboot)
                 _nextKeypadUpdateTs = ts + _intervalKeypad * 1000;
                 updateKeypad(false);
             }
-            if (_preferences->getBool(preference_update_time, false) && ts > (120 * 1000) && ts > _nextTimeUpdateTs)
+            if (_updateTime && ts > (120 * 1000) && ts > _nextTimeUpdateTs)
             {
                 _nextTimeUpdateTs = ts + (12 * 60 * 60 * 1000);
                 updateTime();
@@ -371,31 +393,31 @@ void NukiWrapper::update(bool reboot)
 void NukiWrapper::lock()
 {
 
-    _nextLockAction = NukiLock::LockAction::Lock;
+    _lockActionQueue.push(NukiLock::LockAction::Lock);
 }
 
 void NukiWrapper::unlock()
 {
 
-    _nextLockAction = NukiLock::LockAction::Unlock;
+    _lockActionQueue.push(NukiLock::LockAction::Unlock);
 }
 
 void NukiWrapper::unlatch()
 {
 
-    _nextLockAction = NukiLock::LockAction::Unlatch;
+    _lockActionQueue.push(NukiLock::LockAction::Unlatch);
 }
 
 void NukiWrapper::lockngo()
 {
 
-    _nextLockAction = NukiLock::LockAction::LockNgo;
+    _lockActionQueue.push(NukiLock::LockAction::LockNgo);
 }
 
 void NukiWrapper::lockngounlatch()
 {
 
-    _nextLockAction = NukiLock::LockAction::LockNgoUnlatch;
+    _lockActionQueue.push(NukiLock::LockAction::LockNgoUnlatch);
 }
 
 void NukiWrapper::setPin(uint16_t pin)
@@ -444,7 +466,7 @@ void NukiWrapper::updateAuthData(bool retrieved)
         while (retryCount < _nrOfRetries + 1)
         {
             Log->print(F("[DEBUG] Retrieve log entries: "));
-            result = _nukiLock.retrieveLogEntries(0, _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG), 1, false);
+            result = _nukiLock.retrieveLogEntries(0, _authLogMaxEntries, 1, false);
             if (result != Nuki::CmdResult::Success)
             {
                 ++retryCount;
@@ -464,9 +486,9 @@ void NukiWrapper::updateAuthData(bool retrieved)
             std::list<NukiLock::LogEntry> log;
             _nukiLock.getLogEntries(&log);
 
-            if (log.size() > _preferences->getInt(preference_authlog_max_entries, 3))
+            if (log.size() > _authLogMaxEntries)
             {
-                log.resize(_preferences->getInt(preference_authlog_max_entries, 3));
+                log.resize(_authLogMaxEntries);
             }
 
             log.sort([](const NukiLock::LogEntry &a, const NukiLock::LogEntry &b)
@@ -483,9 +505,9 @@ void NukiWrapper::updateAuthData(bool retrieved)
         std::list<NukiLock::LogEntry> log;
         _nukiLock.getLogEntries(&log);
 
-        if (log.size() > _preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG))
+        if (log.size() > _authLogMaxEntries)
         {
-            log.resize(_preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG));
+            log.resize(_authLogMaxEntries);
         }
 
         log.sort([](const NukiLock::LogEntry &a, const NukiLock::LogEntry &b)
@@ -509,13 +531,11 @@ bool NukiWrapper::updateKeyTurnerState()
     Nuki::CmdResult result = (Nuki::CmdResult)-1;
     int retryCount = 0;
 
-    Log->println(F("[TRACE] Querying lock state"));
+    LOG_TRACE("Querying lock state");
 
     while (result != Nuki::CmdResult::Success && retryCount < _nrOfRetries + 1)
     {
-        Log->print(F("[DEBUG] Result (attempt "));
-        Log->print(retryCount + 1);
-        Log->print("): ");
+        LOG_DEBUG("Query lock state (attempt %d)", retryCount + 1);
         result = _nukiLock.requestKeyTurnerState(&_keyTurnerState);
         ++retryCount;
     }
@@ -531,9 +551,7 @@ bool NukiWrapper::updateKeyTurnerState()
         postponeBleWatchdog();
         if (_retryLockstateCount < _nrOfRetries + 1)
         {
-            Log->print(F("[DEBUG] Query lock state retrying in "));
-            Log->print(_retryDelay);
-            Log->println("ms");
+            LOG_DEBUG("Query lock state retrying in %dms", _retryDelay);
             _nextLockStateUpdateTs = espMillis() + _retryDelay;
         }
         _network->sendToHAKeyTurnerState(_keyTurnerState, _lastKeyTurnerState);
@@ -541,6 +559,7 @@ bool NukiWrapper::updateKeyTurnerState()
     }
 
     _retryLockstateCount = 0;
+    updateLockSnapshot(QUERY_COMMAND_LOCKSTATE);
 
     const NukiLock::LockState &lockState = _keyTurnerState.lockState;
 
@@ -560,7 +579,7 @@ bool NukiWrapper::updateKeyTurnerState()
     else if (espMillis() < _statusUpdatedTs + 10000)
     {
         updateStatus = true;
-        Log->println("[DEBUG] Lock: Keep updating status on intermediate lock state");
+        LOG_DEBUG("Lock: Keep updating status on intermediate lock state");
     }
     else if (lockState == NukiLock::LockState::Undefined)
     {
@@ -570,13 +589,14 @@ bool NukiWrapper::updateKeyTurnerState()
         }
     }
     _network->sendToHAKeyTurnerState(_keyTurnerState, _lastKeyTurnerState);
+    _network->streamKeyTurnerState(_keyTurnerState, _lastKeyTurnerState);
 
     char lockStateStr[20];
     lockstateToString(lockState, lockStateStr);
-    Log->println(lockStateStr);
+    LOG_DEBUG("Lock state: %s", lockStateStr);
 
     postponeBleWatchdog();
-    Log->println("[TRACE] Done querying lock state");
+    LOG_TRACE("Done querying lock state");
     return updateStatus;
 }
 
@@ -586,13 +606,11 @@ bool NukiWrapper::updateBatteryState()
     Nuki::CmdResult result = (Nuki::CmdResult)-1;
     int retryCount = 0;
 
-    Log->println("[TRACE] Querying lock battery state");
+    LOG_TRACE("Querying lock battery state");
 
     while (retryCount < _nrOfRetries + 1)
     {
-        Log->print("[DEBUG] Result (attempt ");
-        Log->print(retryCount + 1);
-        Log->print("): ");
+        LOG_DEBUG("Query lock battery state (attempt %d)", retryCount + 1);
         result = _nukiLock.requestBatteryReport(&_batteryReport);
 
         if (result != Nuki::CmdResult::Success)
@@ -608,10 +626,13 @@ bool NukiWrapper::updateBatteryState()
     printCommandResult(result);
     if (result == Nuki::CmdResult::Success)
     {
+        updateLockSnapshot(QUERY_COMMAND_BATTERY);
         _network->sendToHABatteryReport(_batteryReport);
+        _network->streamBatteryReport(_batteryReport, _lastBatteryReport);
+        memcpy(&_lastBatteryReport, &_batteryReport, sizeof(NukiLock::BatteryReport));
     }
     postponeBleWatchdog();
-    Log->println("[TRACE] Done querying lock battery state");
+    LOG_TRACE("Done querying lock battery state");
     return true;
 }
 
@@ -1029,7 +1050,7 @@ void NukiWrapper::printCommandResult(Nuki::CmdResult result)
 {
     char resultStr[15];
     NukiLock::cmdResultToString(result, resultStr);
-    Log->printf(F("[DEBUG] Nuki::cmdResult = %s\n"), resultStr);
+    LOG_DEBUG("Nuki::cmdResult = %s", resultStr);
 }
 
 String NukiWrapper::hardwareVersion() const
@@ -1083,12 +1104,12 @@ NukiLock::LockAction NukiWrapper::lockActionToEnum(const char *str)
     return (NukiLock::LockAction)0xff;
 }
 
-LockActionResult NukiWrapper::onLockActionReceivedCallback(const char *value)
+LockActionResult NukiWrapper::onLockActionReceivedCallback(const char *value, uint32_t &requestId)
 {
-    return nukiInst->onLockActionReceived(value);
+    return nukiInst->onLockActionReceived(value, requestId);
 }
 
-LockActionResult NukiWrapper::onLockActionReceived(const char *value)
+LockActionResult NukiWrapper::onLockActionReceived(const char *value, uint32_t &requestId)
 {
     NukiLock::LockAction action;
 
@@ -1112,14 +1133,16 @@ LockActionResult NukiWrapper::onLockActionReceived(const char *value)
         return LockActionResult::UnknownAction;
     }
 
-    uint32_t aclPrefs[17];
-    _preferences->getBytes(preference_acl, &aclPrefs, sizeof(aclPrefs));
+    uint32_t aclPrefs[sizeof(nukiInst->_aclPrefs) / sizeof(nukiInst->_aclPrefs[0])];
+    xSemaphoreTake(nukiInst->_aclMutex, portMAX_DELAY);
+    memcpy(aclPrefs, nukiInst->_aclPrefs, sizeof(aclPrefs));
+    xSemaphoreGive(nukiInst->_aclMutex);
 
     if ((action == NukiLock::LockAction::Lock && (int)aclPrefs[0] == 1) || (action == NukiLock::LockAction::Unlock && (int)aclPrefs[1] == 1) || (action == NukiLock::LockAction::Unlatch && (int)aclPrefs[2] == 1) || (action == NukiLock::LockAction::LockNgo && (int)aclPrefs[3] == 1) || (action == NukiLock::LockAction::LockNgoUnlatch && (int)aclPrefs[4] == 1) || (action == NukiLock::LockAction::FullLock && (int)aclPrefs[5] == 1) || (action == NukiLock::LockAction::FobAction1 && (int)aclPrefs[6] == 1) || (action == NukiLock::LockAction::FobAction2 && (int)aclPrefs[7] == 1) || (action == NukiLock::LockAction::FobAction3 && (int)aclPrefs[8] == 1))
     {
-        nukiInst->_nextLockAction = action;
+        requestId = nukiInst->_lockActionQueue.push(action);
 
-        return LockActionResult::Success;
+        return requestId != 0 ? LockActionResult::Success : LockActionResult::QueueFull;
     }
 
     return LockActionResult::AccessDenied;
@@ -1130,11 +1153,133 @@ void NukiWrapper::postponeBleWatchdog()
     _disableBleWatchdogTs = espMillis() + 15000;
 }
 
-void NukiNetwork::setLockActionReceivedCallback(LockActionResult (*lockActionReceivedCallback)(const char *))
+void NukiNetwork::setLockActionReceivedCallback(LockActionResult (*lockActionReceivedCallback)(const char *, uint32_t &))
 {
     _lockActionReceivedCallback = lockActionReceivedCallback;
 }
 
+int64_t NukiWrapper::onLockSnapshotRequestedCallback(uint8_t queryCommand, JsonDocument &json)
+{
+    return nukiInst->lockSnapshotToJson(queryCommand, json);
+}
+
+int64_t NukiWrapper::lockSnapshotToJson(uint8_t queryCommand, JsonDocument &json)
+{
+    switch (queryCommand)
+    {
+    case QUERY_COMMAND_LOCKSTATE:
+    {
+        xSemaphoreTake(_snapshotMutex, portMAX_DELAY);
+        const NukiLock::KeyTurnerState state = _keyTurnerStateSnapshot;
+        const int64_t ts = _keyTurnerStateTs;
+        xSemaphoreGive(_snapshotMutex);
+
+        if (ts == 0)
+        {
+            return 0;
+        }
+
+        char str[50];
+
+        NukiNetwork::keyTurnerStateToJson(json.to<JsonObject>(), state, state, true);
+        lockstateToString(state.lockState, str);
+        json[F("lockStateName")] = str;
+        return ts;
+    }
+    case QUERY_COMMAND_BATTERY:
+    {
+        xSemaphoreTake(_snapshotMutex, portMAX_DELAY);
+        const NukiLock::BatteryReport report = _batteryReportSnapshot;
+        const int64_t ts = _batteryReportTs;
+        xSemaphoreGive(_snapshotMutex);
+
+        if (ts == 0)
+        {
+            return 0;
+        }
+
+        NukiNetwork::batteryReportToJson(json.to<JsonObject>(), report, report, true);
+        return ts;
+    }
+    case QUERY_COMMAND_CONFIG:
+    {
+        xSemaphoreTake(_snapshotMutex, portMAX_DELAY);
+        const NukiLock::Config config = _configSnapshot;
+        const int64_t ts = _configTs;
+        xSemaphoreGive(_snapshotMutex);
+
+        if (ts == 0)
+        {
+            return 0;
+        }
+
+        char str[50];
+
+        json[F("nukiId")] = config.nukiId;
+        memset(str, 0, sizeof(str));
+        memcpy(str, config.name, sizeof(config.name));
+        json[F("name")] = str;
+        json[F("latitude")] = config.latitude;
+        json[F("longitude")] = config.longitude;
+        json[F("autoUnlatch")] = config.autoUnlatch;
+        json[F("pairingEnabled")] = config.pairingEnabled;
+        json[F("buttonEnabled")] = config.buttonEnabled;
+        json[F("ledEnabled")] = config.ledEnabled;
+        json[F("ledBrightness")] = config.ledBrightness;
+        json[F("timeZoneOffset")] = config.timeZoneOffset;
+        json[F("dstMode")] = config.dstMode;
+        json[F("hasFob")] = config.hasFob;
+        json[F("fobAction1")] = config.fobAction1;
+        json[F("fobAction2")] = config.fobAction2;
+        json[F("fobAction3")] = config.fobAction3;
+        json[F("singleLock")] = config.singleLock;
+        json[F("advertisingMode")] = (int)config.advertisingMode;
+        json[F("hasKeypad")] = config.hasKeypad;
+        json[F("hasKeypadV2")] = config.hasKeypadV2;
+        snprintf(str, sizeof(str), "%d.%d.%d", config.firmwareVersion[0], config.firmwareVersion[1], config.firmwareVersion[2]);
+        json[F("firmwareVersion")] = str;
+        snprintf(str, sizeof(str), "%d.%d", config.hardwareRevision[0], config.hardwareRevision[1]);
+        json[F("hardwareRevision")] = str;
+        json[F("homeKitStatus")] = config.homeKitStatus;
+        json[F("timeZoneId")] = (int)config.timeZoneId;
+        json[F("deviceType")] = config.deviceType;
+        json[F("matterStatus")] = config.matterStatus;
+        json[F("productVariant")] = config.productVariant;
+        return ts;
+    }
+    default:
+        return 0;
+    }
+}
+
+void NukiWrapper::updateLockSnapshot(uint8_t queryCommand)
+{
+    int64_t ts = espMillis();
+
+    xSemaphoreTake(_snapshotMutex, portMAX_DELAY);
+    switch (queryCommand)
+    {
+    case QUERY_COMMAND_LOCKSTATE:
+        _keyTurnerStateSnapshot = _keyTurnerState;
+        _keyTurnerStateTs = ts;
+        break;
+    case QUERY_COMMAND_BATTERY:
+        _batteryReportSnapshot = _batteryReport;
+        _batteryReportTs = ts;
+        break;
+    case QUERY_COMMAND_CONFIG:
+        _configSnapshot = _nukiConfig;
+        _configTs = ts;
+        break;
+    }
+    xSemaphoreGive(_snapshotMutex);
+}
+
+void NukiNetwork::setLockSnapshotRequestedCallback(int64_t (*lockSnapshotRequestedCallback)(uint8_t queryCommand, JsonDocument &json))
+{
+    _lockSnapshotRequestedCallback = lockSnapshotRequestedCallback;
+}
+
 void NukiWrapper::notify(Nuki::EventType eventType)
 {
     if (eventType == Nuki::EventType::KeyTurnerStatusUpdated)
@@ -1152,6 +1297,10 @@ void NukiWrapper::readConfig()
     {
         result = _nukiLock.requestConfig(&_nukiConfig);
         _nukiConfigValid = result == Nuki::CmdResult::Success;
+        if (_nukiConfigValid)
+        {
+            updateLockSnapshot(QUERY_COMMAND_CONFIG);
+        }
 
         char resultStr[20];
         NukiLock::cmdResultToString(result, resultStr);
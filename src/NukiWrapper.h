@@ -5,6 +5,7 @@
 #include "BleScanner.h"
 #include <NukiLock.h>
 #include "LockActionResult.h"
+#include "LockActionQueue.h"
 #include "NukiDeviceId.hpp"
 #include "EspMillis.h"
 
@@ -150,16 +151,40 @@ private:
     /**
      * @brief Handles an incoming lock action request from API.
      * @param value Lock action string value.
-     * @return Result of the lock action execution.
+     * @param requestId Receives the id of the queued request.
+     * @return Whether the action was queued.
      */
-    static LockActionResult onLockActionReceivedCallback(const char *value);
+    static LockActionResult onLockActionReceivedCallback(const char *value, uint32_t &requestId);
 
     /**
      * @brief Static callback function for external lock action requests.
      * @param value Lock action string value.
-     * @return Result of the lock action execution.
+     * @param requestId Receives the id of the queued request.
+     * @return Whether the action was queued.
      */
-    LockActionResult onLockActionReceived(const char *value);
+    LockActionResult onLockActionReceived(const char *value, uint32_t &requestId);
+
+    /**
+     * @brief Static callback function for REST snapshot requests.
+     * @param queryCommand QUERY_COMMAND_* of the requested data.
+     * @param json Receives the cached data.
+     * @return espMillis() timestamp of the cached data, 0 if nothing is cached.
+     */
+    static int64_t onLockSnapshotRequestedCallback(uint8_t queryCommand, JsonDocument &json);
+
+    /**
+     * @brief Fills the cached lock state, battery report or config into a JSON document.
+     * @param queryCommand QUERY_COMMAND_LOCKSTATE, QUERY_COMMAND_BATTERY or QUERY_COMMAND_CONFIG.
+     * @param json Receives the cached data.
+     * @return espMillis() timestamp of the cached data, 0 if nothing is cached.
+     */
+    int64_t lockSnapshotToJson(uint8_t queryCommand, JsonDocument &json);
+
+    /**
+     * @brief Copies freshly queried data into the snapshot read by the REST API task.
+     * @param queryCommand QUERY_COMMAND_LOCKSTATE, QUERY_COMMAND_BATTERY or QUERY_COMMAND_CONFIG.
+     */
+    void updateLockSnapshot(uint8_t queryCommand);
 
     /**
      * @brief Resets or delays the BLE watchdog timer.
@@ -260,6 +285,8 @@ private:
     bool _forceDoorsensor = false;                                              // Enforce door sensor presence.
     bool _forceKeypad = false;                                                  // Enforce keypad detection.
     bool _forceId = false;                                                      // Force assignment of a specific device ID.
+    bool _updateTime = false;                                                   // Whether the lock time is synchronized via NTP.
+    int _authLogMaxEntries = MAX_AUTHLOG;                                       // Max number of auth log entries to retrieve.
     bool _keypadEnabled = false;                                                // Indicates if the keypad is currently active.
                                                                                 //
     NukiLock::Config _nukiConfig = {0};                                         // Basic configuration of the lock.
@@ -268,6 +295,8 @@ private:
     bool _nukiAdvancedConfigValid = false;                                      // Whether the advanced configuration is valid.
     uint32_t _basicLockConfigaclPrefs[16];                                      // Stored preference bitfields for access control of basic lock configuration (persisted per ACL entry).
     uint32_t _advancedLockConfigaclPrefs[25];                                   // Stored preference bitfields for access control of advanced lock configuration (persisted per ACL entry).
+    uint32_t _aclPrefs[17];                                                     // Stored preference bitfields for access control of lock actions.
+    SemaphoreHandle_t _aclMutex;                                                // Guards the ACL arrays, written by readSettings(), read by the REST API task.
                                                                                 //
     NukiLock::BatteryReport _batteryReport;                                     // Latest battery status reported by the lock.
     NukiLock::BatteryReport _lastBatteryReport;                                 // Previously stored battery report.
@@ -310,5 +339,13 @@ private:
     int64_t _lastCodeCheck = 0;                                                 // Last time the PIN codes were checked.
     int64_t _lastRssi = 0;                                                      // Last known RSSI value.
                                                                                 //
-    volatile NukiLock::LockAction _nextLockAction = (NukiLock::LockAction)0xff; // Next lock action to be performed via API.
+    LockActionQueue _lockActionQueue;                                           // Lock actions requested via API, waiting for or done by the Nuki task.
+                                                                                //
+    SemaphoreHandle_t _snapshotMutex;                                           // Guards the snapshots below, written by the Nuki task, read by the REST API task.
+    NukiLock::KeyTurnerState _keyTurnerStateSnapshot;                           // Copy of the last successfully queried KeyTurnerState.
+    NukiLock::BatteryReport _batteryReportSnapshot = {};                        // Copy of the last successfully queried battery report.
+    NukiLock::Config _configSnapshot = {0};                                     // Copy of the last successfully queried basic configuration.
+    int64_t _keyTurnerStateTs = 0;                                              // Timestamp of the last successful lock state query.
+    int64_t _batteryReportTs = 0;                                               // Timestamp of the last successful battery report.
+    int64_t _configTs = 0;                                                      // Timestamp of the last successful config query.
 };
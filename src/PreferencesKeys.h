@@ -92,6 +92,9 @@
 #define preference_har_enabled (char *)"haEna"
 #define preference_har_mode (char *)"haMode"
 #define preference_har_rest_mode (char *)"haRestMode"
+#define preference_har_rest_keep_alive (char *)"haRestKeepAl"
+#define preference_har_json_enabled (char *)"haJsonEna"
+#define preference_har_json_path (char *)"haJsonPath"
 #define preference_har_address (char *)"haAddr"
 #define preference_har_port (char *)"haPort"
 #define preference_har_user (char *)"haUsr"
@@ -160,6 +163,7 @@
 #define preference_api_enabled (char *)"ApiEna"
 #define preference_api_port (char *)"ApiPort"
 #define preference_api_token (char *)"ApiToken"
+#define preference_api_event_clients (char *)"ApiEvtClients"
 #define preference_config_from_api (char *)"nhCntrlEnabled"
 
 #define preference_webcfgserver_enabled (char *)"webCfgSrvEna"
@@ -181,6 +185,7 @@
 #define preference_log_backup_ftp_user (char *)"logBckUsr"
 #define preference_log_backup_ftp_pwd (char *)"logBckPwd"
 #define preference_log_backup_file_index (char *)"logBckFileId" // not user-changeable
+#define preference_log_binary (char *)"logBinary"
 
 inline bool initPreferences(Preferences *&preferences)
 {
@@ -6,11 +6,21 @@
 #define api_path_bridge_enable_api (char*)"/enableApi"
 #define api_path_bridge_reboot (char*)"/reboot"
 #define api_path_bridge_enable_web_server (char*)"/enableWebServer"
+#define api_path_bridge_stats (char*)"/stats"
 
 // main path for lock
 #define api_path_lock (char*)"/lock"
 
 #define api_path_lock_action (char*)"/action"
+#define api_path_lock_action_status (char*)"/action/status"
+
+// cached snapshots, answered without BLE traffic
+#define api_path_lock_state (char*)"/state"
+#define api_path_lock_battery (char*)"/battery"
+#define api_path_lock_config (char*)"/config"
+
+// text/event-stream of lock state and battery changes
+#define api_path_lock_events (char*)"/events"
 
 #define api_path_query_config (char*)"/query/config"
 #define api_path_query_lockstate (char*)"/query/lockstate"
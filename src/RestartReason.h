@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Logger.h"
+
 /**
  * @brief Represents the reason why the ESP32 was restarted or shut down.
  */
@@ -53,6 +55,8 @@ inline static void safeShutdownESP(RestartReason reason)
 {
     restartReason = (int)reason;
     restartReasonValidDetect = RESTART_REASON_VALID_DETECT;
+    if (Log)
+        Log->flush(); // write pending log lines before unmounting
     LittleFS.end();
     delay(10);                        // to ensure that all pending write operations are completed
     esp_sleep_enable_timer_wakeup(0); // No automatic wake-up
@@ -68,6 +72,8 @@ inline static void restartEsp(RestartReason reason)
 {
     restartReason = (int)reason;
     restartReasonValidDetect = RESTART_REASON_VALID_DETECT;
+    if (Log)
+        Log->flush(); // write pending log lines before unmounting
     LittleFS.end();
     delay(10); // to ensure that all pending write operations are completed
     ESP.restart();
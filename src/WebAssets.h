@@ -0,0 +1,231 @@
+#pragma once
+
+// Generated by pio_web_assets.py from the files in web/, do not edit.
+
+#include <Arduino.h>
+
+/**
+ * @brief Gzipped static file of the web configurator.
+ */
+struct WebAsset
+{
+    const char *path;        // Request path
+    const char *contentType; // Content type of the uncompressed file
+    const char *etag;        // Strong ETag incl. quotes
+    const uint8_t *data;     // Gzipped content
+    size_t size;             // Length of data
+};
+
+// web/style.css: 4165 bytes, 1519 bytes gzipped
+#define WEB_ASSET_STYLE_CSS_VERSION "4075b40311b92b7f"
+static const uint8_t webAssetStyleCss[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x57, 0x6d, 0x6b, 0xe4, 0x36,
+    0x10, 0xfe, 0xde, 0x5f, 0xe1, 0x12, 0x8e, 0xcd, 0x16, 0x79, 0xf1, 0x7a, 0x5f, 0x92, 0x93, 0xe9,
+    0xd1, 0x36, 0xb4, 0xf4, 0xa0, 0xd7, 0x83, 0x86, 0xfb, 0x74, 0xe4, 0x83, 0x6c, 0xcb, 0x6b, 0x35,
+    0xb6, 0x64, 0x64, 0x6d, 0x76, 0xb7, 0xc6, 0xff, 0xbd, 0x23, 0x4b, 0x7e, 0x5b, 0x3b, 0xb9, 0x42,
+    0x09, 0x21, 0xd1, 0xcc, 0x68, 0xf4, 0xcc, 0xfb, 0x18, 0x4b, 0x21, 0x54, 0xe5, 0xba, 0x3c, 0x72,
+    0x13, 0xc1, 0x95, 0x5b, 0x12, 0x5e, 0xe2, 0xc5, 0x47, 0xae, 0xa8, 0x5c, 0x20, 0x97, 0x14, 0x45,
+    0x46, 0xdd, 0xf2, 0x52, 0x2a, 0x9a, 0xa3, 0x5f, 0x32, 0xc6, 0x9f, 0x3f, 0x91, 0xe8, 0xb1, 0x39,
+    0xfe, 0x06, 0xd2, 0x68, 0xf1, 0x48, 0x0f, 0x82, 0x3a, 0x5f, 0x3e, 0x2e, 0xd0, 0x5f, 0x22, 0x14,
+    0x4a, 0xa0, 0xcf, 0xe7, 0xcb, 0x81, 0x72, 0xf4, 0x25, 0x3c, 0x72, 0x75, 0x44, 0x0f, 0x84, 0x2b,
+    0x22, 0x69, 0x96, 0xa1, 0xc5, 0xe7, 0x82, 0x72, 0xe7, 0x11, 0xb4, 0x2f, 0xd0, 0xe2, 0x77, 0x9a,
+    0xbd, 0x50, 0xc5, 0x22, 0xe2, 0xfc, 0x49, 0x8f, 0x74, 0x81, 0xf4, 0xa3, 0x6e, 0x49, 0x25, 0x4b,
+    0xd0, 0xe2, 0x67, 0xfd, 0xa4, 0xf3, 0x20, 0x32, 0x21, 0x9d, 0x5f, 0x73, 0xf1, 0x37, 0x5b, 0xf4,
+    0xaf, 0x4c, 0x09, 0x8f, 0x97, 0x3c, 0x14, 0xd9, 0x22, 0xe8, 0x0d, 0xc8, 0x05, 0x17, 0xf8, 0x41,
+    0xf0, 0x52, 0x64, 0xa4, 0x44, 0x70, 0x22, 0x91, 0x40, 0x0b, 0x83, 0xc7, 0xf9, 0x04, 0x4c, 0xb8,
+    0xfe, 0x07, 0x0b, 0xa9, 0x24, 0x8a, 0x09, 0xde, 0x52, 0x1e, 0xc4, 0x51, 0x32, 0x2a, 0x01, 0xcf,
+    0x69, 0x81, 0xec, 0x41, 0x5f, 0x16, 0x65, 0x41, 0x22, 0x6a, 0xd4, 0xab, 0xb3, 0xbb, 0xc6, 0x37,
+    0x9e, 0xe7, 0x75, 0x47, 0x1f, 0xdf, 0xac, 0x89, 0xfe, 0x31, 0x94, 0xf0, 0xa0, 0x05, 0x92, 0x24,
+    0xe9, 0x8e, 0x20, 0x90, 0xec, 0x93, 0xfb, 0xa4, 0x17, 0xd8, 0xe0, 0x1b, 0xba, 0xa3, 0x77, 0x34,
+    0x34, 0x94, 0xec, 0xd9, 0xe8, 0xbc, 0xf3, 0x92, 0x4d, 0x47, 0x81, 0x5b, 0xde, 0x66, 0xbf, 0x8f,
+    0xf7, 0x1d, 0x45, 0x9d, 0x07, 0x7a, 0x49, 0xa4, 0xef, 0xdc, 0xbd, 0x4f, 0x12, 0xba, 0xee, 0x28,
+    0x5a, 0xc2, 0x8b, 0xb6, 0xde, 0xf6, 0xae, 0xfe, 0x29, 0xa7, 0x31, 0x23, 0xb7, 0x85, 0xa4, 0x09,
+    0x95, 0xa5, 0x1b, 0x69, 0x57, 0xba, 0x65, 0x94, 0xd2, 0x9c, 0xe2, 0x98, 0xc8, 0xe7, 0x65, 0x85,
+    0xfb, 0xa0, 0x1b, 0xa3, 0x3a, 0xdd, 0xc6, 0x28, 0x4a, 0xe9, 0xd0, 0xa2, 0xce, 0x64, 0x63, 0xd1,
+    0x7a, 0xbd, 0x1e, 0x9a, 0xe3, 0xfb, 0xfe, 0xd0, 0x96, 0x8d, 0xff, 0x7e, 0xdd, 0x6a, 0xb3, 0xb6,
+    0x8c, 0xad, 0x9b, 0xb5, 0xc5, 0xbf, 0x8f, 0xc8, 0xc8, 0x16, 0x90, 0xa8, 0xeb, 0x1f, 0xaa, 0x9c,
+    0xc8, 0x03, 0xe3, 0xd8, 0x0b, 0x0a, 0x12, 0xc7, 0x8c, 0x1f, 0xb0, 0x57, 0xb3, 0xfc, 0x80, 0x18,
+    0x2f, 0x8e, 0x0a, 0x89, 0x42, 0x87, 0x10, 0x15, 0x48, 0x91, 0x30, 0xa3, 0x48, 0xd1, 0xb3, 0x4e,
+    0x36, 0x82, 0x8e, 0x99, 0xbd, 0xe7, 0x42, 0x4a, 0x2a, 0x91, 0xe3, 0xb5, 0xa4, 0x79, 0x1d, 0x1e,
+    0xe1, 0x7f, 0x8e, 0x52, 0x95, 0x67, 0xf6, 0x7e, 0x49, 0x33, 0x1a, 0xa9, 0xaa, 0x49, 0x9b, 0x84,
+    0xe4, 0x2c, 0xbb, 0xe0, 0x17, 0x22, 0x6f, 0xc7, 0xc5, 0xb0, 0xac, 0x43, 0x11, 0x5f, 0x3a, 0x20,
+    0x0e, 0x39, 0x2a, 0x11, 0xe4, 0xe4, 0xec, 0x9e, 0x58, 0xac, 0x52, 0x7c, 0xb7, 0xf3, 0x8a, 0x73,
+    0x87, 0xce, 0x87, 0x87, 0x82, 0x50, 0xc8, 0x98, 0x4a, 0x57, 0x92, 0x98, 0x1d, 0x4b, 0xbc, 0x07,
+    0xb6, 0x78, 0xa1, 0x32, 0xc9, 0xc4, 0xc9, 0x3d, 0xe3, 0x94, 0xc5, 0x31, 0xe5, 0xc1, 0x09, 0x64,
+    0xdc, 0x10, 0xc0, 0x3e, 0x63, 0x2e, 0x64, 0x4e, 0xb2, 0x5e, 0xe6, 0x24, 0x49, 0x81, 0x09, 0xbf,
+    0x9c, 0x52, 0x2a, 0x69, 0x10, 0x92, 0xe8, 0xf9, 0x20, 0xc5, 0x91, 0xc7, 0x3d, 0x36, 0x1d, 0x95,
+    0x65, 0xd0, 0xc4, 0xb5, 0x27, 0xea, 0xc8, 0x2d, 0x03, 0x03, 0x9b, 0xfd, 0x43, 0xf1, 0x7a, 0xe5,
+    0x6d, 0x34, 0x1a, 0x28, 0x5a, 0xea, 0xa6, 0x94, 0x1d, 0x52, 0x05, 0xb4, 0x5d, 0x8d, 0xb1, 0x31,
+    0x1b, 0x3c, 0x57, 0xcd, 0x29, 0xd7, 0x11, 0x99, 0x28, 0x6f, 0x82, 0xb2, 0xac, 0xd3, 0x35, 0x4a,
+    0x7d, 0x94, 0x6e, 0x50, 0xba, 0x45, 0xe9, 0x0e, 0xa5, 0xfb, 0x6a, 0xa4, 0x7d, 0x06, 0x12, 0xa8,
+    0xb2, 0xbe, 0x71, 0x95, 0x28, 0xf0, 0xea, 0xfe, 0x6e, 0xa7, 0x63, 0xd1, 0x2a, 0xaa, 0xde, 0xbc,
+    0x61, 0xa3, 0xe7, 0x83, 0x07, 0xc7, 0xf1, 0xbc, 0x07, 0x8a, 0xf5, 0x72, 0x1b, 0xe1, 0xe2, 0xec,
+    0x40, 0xc5, 0xb3, 0xd8, 0x19, 0x7a, 0xc9, 0x07, 0xc8, 0x2d, 0xd2, 0xb1, 0x86, 0xd5, 0xc6, 0xc0,
+    0xa8, 0x7a, 0x87, 0xf9, 0x2b, 0xdf, 0x60, 0xf3, 0xab, 0xa1, 0x17, 0xef, 0x0d, 0x71, 0x33, 0x22,
+    0xee, 0x0c, 0x71, 0x3b, 0x22, 0xda, 0xeb, 0xbb, 0x21, 0xb1, 0xa1, 0xec, 0x07, 0x94, 0xd6, 0x03,
+    0xe4, 0xda, 0x74, 0x5d, 0x3d, 0xcb, 0x9a, 0xe0, 0x54, 0x27, 0xc2, 0x0c, 0xd3, 0x5f, 0x3a, 0xdf,
+    0xb3, 0xbc, 0x10, 0x52, 0x41, 0x4f, 0x0d, 0x6a, 0x12, 0x86, 0x20, 0x75, 0x94, 0x25, 0x88, 0xa5,
+    0x34, 0x2b, 0x1a, 0x42, 0x7b, 0x79, 0x48, 0x76, 0x6c, 0xde, 0xdb, 0x3f, 0x4d, 0xe6, 0x7f, 0x55,
+    0x97, 0x82, 0xfe, 0x68, 0x28, 0x4f, 0x43, 0x92, 0xa4, 0x25, 0x55, 0x23, 0x4a, 0x79, 0x0c, 0x73,
+    0xa6, 0x9e, 0xae, 0x6c, 0x0a, 0x62, 0x56, 0x16, 0x19, 0xb9, 0x60, 0xc6, 0x9b, 0x0c, 0x08, 0x33,
+    0x11, 0x3d, 0x77, 0x55, 0x00, 0x29, 0xef, 0xac, 0x75, 0xd4, 0x74, 0x45, 0xba, 0x24, 0x63, 0x07,
+    0x8e, 0x23, 0xaa, 0x47, 0x8a, 0xa1, 0xc4, 0x34, 0x12, 0xa6, 0xfd, 0x42, 0xf2, 0x73, 0x1a, 0x9c,
+    0x52, 0xa6, 0x60, 0xca, 0xe8, 0x4e, 0x0b, 0x04, 0x9d, 0xff, 0xb3, 0x69, 0xdf, 0x78, 0x28, 0x98,
+    0x7a, 0x06, 0x32, 0xd3, 0x66, 0x03, 0xf4, 0x89, 0x71, 0xf1, 0x6d, 0x9b, 0x44, 0x39, 0x6b, 0xe0,
+    0x1a, 0x58, 0x97, 0x33, 0xe7, 0xc0, 0xfa, 0xa8, 0x10, 0xac, 0xc1, 0x35, 0xab, 0xb5, 0x73, 0xde,
+    0x57, 0x30, 0x57, 0xb7, 0x98, 0xf8, 0x09, 0x4d, 0x08, 0x53, 0x87, 0xce, 0x33, 0x8d, 0x6b, 0xe7,
+    0x79, 0xd6, 0xc9, 0x3d, 0xb3, 0x0d, 0x61, 0x4c, 0x13, 0x72, 0xcc, 0x54, 0x20, 0xc0, 0x37, 0x4c,
+    0x5d, 0xf0, 0x6a, 0xd7, 0x02, 0xe7, 0x42, 0x7b, 0x16, 0xfa, 0x05, 0x8d, 0xeb, 0x95, 0x79, 0x18,
+    0x27, 0x22, 0x3a, 0x96, 0xa8, 0x3d, 0x35, 0xb9, 0x80, 0x46, 0xac, 0x11, 0x67, 0x0a, 0xdc, 0x4a,
+    0xcd, 0x30, 0x26, 0x37, 0x8c, 0x35, 0xd3, 0x0b, 0x96, 0x3e, 0x91, 0xb7, 0x16, 0x4e, 0x2f, 0xb4,
+    0x0c, 0x93, 0xb9, 0xaf, 0x84, 0x1d, 0xea, 0xb8, 0x69, 0xf1, 0x95, 0x0d, 0x20, 0x44, 0x2b, 0x23,
+    0x45, 0x49, 0x71, 0xfb, 0x4f, 0x60, 0x9a, 0xf1, 0xda, 0xf3, 0xde, 0xd5, 0x2a, 0x46, 0x2a, 0xb5,
+    0x92, 0xaf, 0xf4, 0x85, 0xcd, 0x72, 0x98, 0x9a, 0x19, 0x4d, 0x54, 0x97, 0xbb, 0xab, 0xa6, 0x3a,
+    0xb5, 0x82, 0xf9, 0xc6, 0xab, 0xa1, 0x80, 0xf7, 0x55, 0xea, 0x46, 0x29, 0xcb, 0xe2, 0x5b, 0xfa,
+    0x42, 0xf9, 0xf2, 0x2d, 0x61, 0x3b, 0x94, 0xaa, 0x7e, 0x64, 0x34, 0x28, 0x87, 0x13, 0xa8, 0x9b,
+    0x5c, 0xd5, 0xa4, 0x82, 0xae, 0xba, 0xd6, 0xae, 0x99, 0x2f, 0xaf, 0x3d, 0x36, 0x3f, 0x12, 0xbe,
+    0xe5, 0x89, 0x57, 0x2a, 0x26, 0x25, 0xb1, 0x38, 0x99, 0xfa, 0x9c, 0xad, 0x20, 0x3d, 0x87, 0xaf,
+    0x8d, 0x52, 0xf1, 0x87, 0xc6, 0xae, 0xb6, 0xd9, 0xea, 0x96, 0xef, 0x5d, 0xd9, 0xe0, 0x69, 0xa9,
+    0x81, 0x57, 0xde, 0x16, 0xb4, 0x23, 0xfa, 0x4d, 0xb1, 0xd5, 0x89, 0x48, 0x0e, 0xe0, 0x6c, 0xd3,
+    0x94, 0x50, 0x11, 0x66, 0x05, 0x72, 0x04, 0xcf, 0x2e, 0x4e, 0x19, 0x49, 0x0a, 0xab, 0x27, 0xe1,
+    0xb1, 0x73, 0xdb, 0xe3, 0xdd, 0x7b, 0x30, 0xb7, 0x97, 0xd5, 0x8a, 0xc4, 0xa4, 0x50, 0x8e, 0x8a,
+    0xab, 0xb6, 0xa3, 0x35, 0xad, 0xac, 0xb6, 0xf4, 0x41, 0xa2, 0x6a, 0xc8, 0x4f, 0x68, 0x4a, 0x2f,
+    0x48, 0x59, 0xea, 0x69, 0x3e, 0xc7, 0xb3, 0xc9, 0xdd, 0x72, 0xba, 0x05, 0xc5, 0x9e, 0xad, 0x71,
+    0x03, 0x07, 0x76, 0x70, 0x70, 0x4a, 0xca, 0xdb, 0x81, 0x26, 0xd8, 0xde, 0xa2, 0x67, 0xf0, 0xfa,
+    0xd3, 0xb2, 0x9a, 0x34, 0xd5, 0x19, 0xb0, 0x9d, 0x78, 0xab, 0x7c, 0xb5, 0x83, 0xc4, 0xe9, 0xb7,
+    0x00, 0x48, 0xf1, 0xf6, 0x29, 0x5d, 0x57, 0xfa, 0xc1, 0x84, 0xc9, 0x52, 0x99, 0xa4, 0xae, 0xc6,
+    0xb3, 0xd5, 0x9b, 0xc8, 0xc2, 0x66, 0x7d, 0x25, 0xda, 0x44, 0xa6, 0xbe, 0x51, 0x61, 0xc6, 0xc9,
+    0x8b, 0x43, 0x9c, 0x8c, 0x7d, 0x80, 0x7e, 0xce, 0x87, 0x09, 0xb2, 0x05, 0x87, 0xd7, 0xbd, 0x48,
+    0x75, 0xdd, 0xb2, 0xaf, 0x27, 0x79, 0x30, 0x8a, 0x48, 0x70, 0x35, 0x80, 0x9a, 0xe3, 0xc9, 0x18,
+    0x04, 0x5f, 0x00, 0x71, 0x5f, 0xc0, 0x7b, 0x60, 0x3b, 0x5e, 0xf0, 0x1f, 0x36, 0x93, 0xd9, 0x61,
+    0x34, 0xa8, 0x2e, 0xad, 0x82, 0x48, 0xf7, 0xa0, 0x4b, 0x03, 0x3c, 0x7d, 0xab, 0x84, 0xa3, 0x7b,
+    0x05, 0x52, 0x12, 0xf6, 0xc2, 0x02, 0x22, 0xc9, 0x95, 0xb3, 0xf3, 0xde, 0x21, 0x79, 0x08, 0xc9,
+    0xad, 0xbf, 0xdb, 0xa1, 0xf6, 0xd7, 0x5b, 0x6d, 0x97, 0x9a, 0xb3, 0x74, 0xa4, 0x7e, 0x7f, 0xa0,
+    0xd3, 0xae, 0x1a, 0x10, 0x6b, 0x47, 0x07, 0x3c, 0x68, 0x54, 0xb1, 0xe6, 0x75, 0xe8, 0xe6, 0xce,
+    0xca, 0x2f, 0x1d, 0x4a, 0x4a, 0x3a, 0x74, 0xd3, 0xb7, 0xf1, 0x8c, 0xbb, 0xc0, 0xff, 0x84, 0xd4,
+    0x3f, 0x3d, 0xe9, 0xc9, 0x6e, 0x21, 0x2c, 0xd6, 0xa6, 0x65, 0x5e, 0x63, 0xdf, 0xee, 0xae, 0xc1,
+    0x63, 0x02, 0x7b, 0xe6, 0x0b, 0xad, 0x5e, 0x9f, 0xe6, 0xd7, 0x3a, 0xd6, 0x13, 0x1d, 0x90, 0x4a,
+    0xb0, 0x65, 0x42, 0xbe, 0x95, 0xea, 0x92, 0x51, 0x13, 0xa3, 0x51, 0xb3, 0x9e, 0xdf, 0x45, 0x06,
+    0x45, 0x35, 0xcd, 0x4a, 0xd8, 0xb3, 0x89, 0xc2, 0xc6, 0x11, 0x83, 0x72, 0x32, 0x04, 0xdb, 0x5e,
+    0xa4, 0xc9, 0x1c, 0xbd, 0xdd, 0x9b, 0xe4, 0xb9, 0x49, 0xee, 0xbc, 0x51, 0xda, 0x81, 0x72, 0x9b,
+    0x95, 0x0d, 0x32, 0xa6, 0x40, 0x4b, 0x14, 0x5c, 0xf5, 0x11, 0x15, 0x87, 0x8a, 0x4f, 0x6b, 0x36,
+    0x00, 0xcf, 0xea, 0x0f, 0xe0, 0xcc, 0x52, 0x73, 0xf8, 0x2c, 0xc8, 0x68, 0xbd, 0x02, 0x9c, 0xc0,
+    0x97, 0x17, 0x0b, 0xb1, 0xf1, 0x73, 0x5f, 0x43, 0x9b, 0xbb, 0x1d, 0xc0, 0x19, 0xf6, 0x0b, 0x28,
+    0x49, 0xd7, 0x0c, 0xe9, 0xd5, 0xc4, 0xd7, 0xe6, 0xcb, 0x0f, 0x3b, 0xb3, 0xab, 0xbd, 0x73, 0xb5,
+    0xdb, 0x8f, 0x2c, 0x73, 0x9a, 0x8a, 0x02, 0xed, 0xb2, 0x2c, 0x59, 0x3c, 0xde, 0x2a, 0xc7, 0x1b,
+    0x53, 0x98, 0x1d, 0x69, 0xfd, 0xdd, 0xbf, 0x69, 0xc6, 0xaa, 0x6f, 0x45, 0x10, 0x00, 0x00,
+};
+
+// web/app.js: 4998 bytes, 1663 bytes gzipped
+#define WEB_ASSET_APP_JS_VERSION "cad6b8d952372066"
+static const uint8_t webAssetAppJs[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x58, 0x6d, 0x53, 0x1b, 0x37,
+    0x10, 0xfe, 0xce, 0xaf, 0x10, 0x6e, 0xa7, 0x77, 0x97, 0x9a, 0x33, 0x90, 0x90, 0x49, 0x70, 0x9c,
+    0x0c, 0x49, 0x68, 0xa1, 0x0d, 0x81, 0x62, 0x3a, 0xed, 0x0c, 0x43, 0x32, 0xf2, 0x9d, 0x6c, 0x2b,
+    0xc8, 0xd2, 0xf5, 0xa4, 0xc3, 0x90, 0x84, 0xfe, 0xf6, 0xee, 0xea, 0x5e, 0xac, 0xbb, 0x33, 0x86,
+    0x49, 0xdb, 0xfb, 0x82, 0x25, 0xed, 0x3e, 0xbb, 0xda, 0x77, 0xd1, 0xeb, 0x91, 0xe1, 0x94, 0xa6,
+    0x2c, 0x26, 0x3a, 0x4a, 0x79, 0x62, 0x34, 0x51, 0x63, 0x62, 0xa6, 0x8c, 0xcc, 0xd9, 0x88, 0x44,
+    0x4a, 0x8e, 0xf9, 0x24, 0x4b, 0xa9, 0x51, 0x69, 0x97, 0x68, 0x96, 0x5e, 0x01, 0xdd, 0xe4, 0x33,
+    0x4f, 0x12, 0xf8, 0x4b, 0x35, 0xe9, 0xd1, 0x24, 0x09, 0x3f, 0xe9, 0x70, 0xad, 0xd7, 0x23, 0x27,
+    0x74, 0xc2, 0x80, 0x59, 0x8a, 0x1b, 0x12, 0x51, 0x21, 0x2c, 0x06, 0x97, 0xdc, 0x90, 0x71, 0x26,
+    0x23, 0xc3, 0x95, 0xc4, 0x9d, 0x1b, 0x22, 0x19, 0x8b, 0xbb, 0x84, 0x85, 0x93, 0x90, 0xcc, 0xb9,
+    0x8c, 0xd5, 0x3c, 0x04, 0x16, 0x45, 0x63, 0x32, 0xb0, 0xd4, 0x43, 0x43, 0x4d, 0xa6, 0xfb, 0x6b,
+    0x88, 0xb8, 0xb1, 0xb1, 0x41, 0xf2, 0x35, 0x49, 0x00, 0x1c, 0xd7, 0x6b, 0x82, 0x19, 0xa2, 0xed,
+    0xde, 0x19, 0x9f, 0xb1, 0x14, 0xb8, 0x64, 0x26, 0x04, 0xd0, 0x57, 0x52, 0xb2, 0x24, 0xa6, 0x86,
+    0x1d, 0xca, 0xb1, 0xf2, 0x03, 0xf2, 0x65, 0x8d, 0xc0, 0x77, 0x45, 0x53, 0x92, 0xb2, 0xbf, 0x32,
+    0xa6, 0x0d, 0x32, 0xb0, 0x39, 0xf9, 0xf3, 0xe8, 0xdd, 0x81, 0x31, 0xc9, 0x69, 0xbe, 0xe9, 0x07,
+    0x7d, 0x4b, 0x57, 0xd0, 0x84, 0x2a, 0x61, 0xd2, 0xf7, 0x7e, 0xde, 0x3f, 0xf3, 0xba, 0xc4, 0xeb,
+    0x4d, 0x98, 0x79, 0x85, 0xf2, 0x07, 0xb9, 0x5c, 0xd8, 0x33, 0x69, 0xc6, 0x9a, 0x2c, 0xe5, 0x25,
+    0x40, 0xe8, 0xe0, 0x65, 0x21, 0x17, 0x3f, 0x30, 0x21, 0x48, 0x55, 0xa3, 0x4f, 0x70, 0xf6, 0xcb,
+    0xf0, 0xf8, 0x7d, 0x98, 0xd0, 0x54, 0x33, 0xbf, 0xe4, 0x4b, 0x99, 0x4e, 0x80, 0x82, 0x9d, 0xb1,
+    0x6b, 0x53, 0x40, 0xe2, 0xc7, 0xc7, 0xc4, 0x07, 0x9e, 0x50, 0x1b, 0x95, 0x90, 0xc1, 0x80, 0x6c,
+    0x05, 0x0e, 0xa4, 0x85, 0x15, 0x8c, 0xa6, 0x87, 0xd2, 0x80, 0x4b, 0xa8, 0xf0, 0x1d, 0x8b, 0x38,
+    0x20, 0xb7, 0xd5, 0xaf, 0xb1, 0x4a, 0x89, 0x8f, 0x56, 0xb8, 0x04, 0x0f, 0x80, 0x7f, 0x8f, 0x47,
+    0x9f, 0x58, 0x64, 0x42, 0x58, 0x69, 0x14, 0x13, 0x34, 0xd1, 0x51, 0x3c, 0x92, 0x82, 0x64, 0x4f,
+    0x19, 0xea, 0x91, 0x1f, 0x7e, 0x20, 0xb1, 0x8a, 0xb2, 0x19, 0x93, 0x26, 0x04, 0x7b, 0xec, 0x0b,
+    0x86, 0x3f, 0x5f, 0xdf, 0x1c, 0xc6, 0x48, 0x17, 0x90, 0xf5, 0x41, 0xee, 0x88, 0x26, 0x10, 0x7e,
+    0xab, 0x18, 0x43, 0x2e, 0x25, 0x4b, 0xf1, 0xf2, 0x60, 0x9e, 0xce, 0x0b, 0x4a, 0xa6, 0x29, 0x1b,
+    0x0f, 0xbc, 0x1e, 0x0a, 0x7d, 0xd9, 0x21, 0x3f, 0xa2, 0xe1, 0xce, 0x81, 0xf0, 0x02, 0x7e, 0x76,
+    0x5e, 0xf4, 0xe8, 0xcb, 0x4e, 0xbf, 0x86, 0x7f, 0x4b, 0x98, 0xd0, 0xcc, 0xea, 0xfb, 0xff, 0xeb,
+    0x57, 0xea, 0xd2, 0x50, 0xa1, 0x61, 0xef, 0xdb, 0x7a, 0x60, 0x68, 0x26, 0x63, 0x8c, 0xaf, 0x5b,
+    0x27, 0x44, 0x17, 0x81, 0x5e, 0x85, 0xa8, 0x1b, 0xb5, 0x39, 0x40, 0x3d, 0xca, 0x35, 0x33, 0x95,
+    0xb7, 0x17, 0xb4, 0x5d, 0xf2, 0x78, 0x73, 0x73, 0x33, 0x47, 0x2f, 0x12, 0x66, 0x2f, 0xbe, 0xa2,
+    0x32, 0x82, 0xf4, 0x5c, 0xe4, 0x2e, 0x8a, 0xc4, 0xdc, 0xa9, 0xe4, 0x43, 0x7e, 0x46, 0x99, 0x00,
+    0x8c, 0x5a, 0x86, 0xd0, 0xcc, 0x4c, 0x41, 0xd2, 0x5d, 0xe6, 0xe8, 0x70, 0x99, 0x64, 0x66, 0x46,
+    0xaf, 0x91, 0xae, 0x13, 0x84, 0xa0, 0x49, 0xc6, 0xfa, 0x35, 0x6e, 0xa1, 0x26, 0x0f, 0x05, 0x00,
+    0xd2, 0x36, 0x06, 0x18, 0x37, 0xb1, 0x49, 0x74, 0x2f, 0x44, 0x4e, 0xd9, 0x46, 0x30, 0x60, 0x2e,
+    0xb8, 0xb8, 0x49, 0x95, 0x78, 0x08, 0x8c, 0x43, 0xde, 0xc6, 0x8a, 0xa0, 0x2c, 0x8e, 0xb2, 0x31,
+    0xe0, 0x6c, 0x76, 0xa1, 0x68, 0x98, 0xb9, 0x4a, 0x2f, 0x0d, 0xd5, 0x97, 0xb8, 0xb1, 0xa0, 0xd2,
+    0xfc, 0x33, 0x2b, 0x2c, 0x07, 0xbe, 0x20, 0x8f, 0xac, 0x21, 0xba, 0xd5, 0x76, 0x6e, 0x92, 0xed,
+    0x67, 0xe5, 0x09, 0xac, 0xf3, 0xc3, 0xea, 0xae, 0x8f, 0x77, 0xf0, 0x2c, 0x5f, 0xe6, 0x47, 0xf5,
+    0x4b, 0x6c, 0x6d, 0xe3, 0xb9, 0xb3, 0x97, 0xcb, 0x5e, 0x68, 0x77, 0x44, 0xcd, 0x34, 0x84, 0xcb,
+    0xf8, 0xa5, 0xcc, 0x9a, 0x74, 0x57, 0x5a, 0x0b, 0xbe, 0x4b, 0x9e, 0x6c, 0x3e, 0x7f, 0x1a, 0x2c,
+    0x47, 0xe4, 0xd2, 0x2f, 0xb6, 0xba, 0xe4, 0xe9, 0xce, 0xce, 0xe3, 0x92, 0xae, 0x6e, 0x8a, 0x4a,
+    0x3a, 0x22, 0x41, 0x96, 0x56, 0x2c, 0xcf, 0xb6, 0x9e, 0x6f, 0xaf, 0xe0, 0x00, 0x74, 0x67, 0xbb,
+    0x2e, 0xe1, 0x4e, 0xbf, 0x01, 0x57, 0x81, 0x3f, 0x66, 0x69, 0xa7, 0xc8, 0xce, 0x83, 0xb3, 0xa3,
+    0x77, 0x00, 0x5b, 0x1c, 0xdc, 0x8f, 0xe0, 0x88, 0x6d, 0x40, 0x38, 0x27, 0xed, 0x84, 0x2d, 0x13,
+    0xeb, 0x8d, 0xcd, 0xab, 0x2a, 0x73, 0xce, 0x5b, 0x61, 0xdd, 0x25, 0xcd, 0x30, 0x75, 0x76, 0xdc,
+    0x88, 0x73, 0xb6, 0x6d, 0x4e, 0x5d, 0x84, 0x50, 0xa7, 0xf7, 0x69, 0x34, 0xf5, 0x79, 0x5c, 0x6f,
+    0x22, 0x77, 0x5d, 0x87, 0xc7, 0x41, 0x48, 0xe3, 0x78, 0xff, 0x0a, 0x36, 0xde, 0x71, 0x6d, 0x18,
+    0xdc, 0xc5, 0xef, 0x80, 0xd4, 0x2c, 0x01, 0xf4, 0x2a, 0xcd, 0x0b, 0xb3, 0xde, 0x96, 0x8e, 0x5e,
+    0xa4, 0xbf, 0x5b, 0x39, 0xde, 0xc0, 0x10, 0x00, 0x38, 0x9c, 0x0a, 0x5d, 0x2f, 0x17, 0x06, 0xea,
+    0x58, 0x04, 0x87, 0xba, 0x56, 0x2e, 0xac, 0xea, 0x1f, 0x33, 0x6d, 0xcb, 0xd3, 0xea, 0x4c, 0x43,
+    0xa2, 0x76, 0x7e, 0xe5, 0x00, 0x09, 0xd5, 0xfa, 0x5e, 0x00, 0x24, 0x5a, 0x05, 0xb0, 0xfd, 0x20,
+    0x84, 0xed, 0x36, 0x44, 0x42, 0x0d, 0x14, 0x55, 0x09, 0xec, 0xbd, 0x0f, 0xe7, 0x64, 0xe3, 0xef,
+    0x8b, 0x47, 0xdf, 0xf7, 0xf2, 0x53, 0x6c, 0x29, 0xee, 0x15, 0xa1, 0x13, 0x7e, 0xe7, 0x91, 0xaf,
+    0x5f, 0x49, 0x63, 0xd3, 0x03, 0x9b, 0x40, 0xb1, 0x37, 0x19, 0xa0, 0xe0, 0x5c, 0xd0, 0x2f, 0xda,
+    0xc0, 0x82, 0xdf, 0xde, 0x70, 0x7d, 0xe0, 0xaa, 0x8b, 0x3c, 0x54, 0xb0, 0xd4, 0xf8, 0xde, 0x09,
+    0xac, 0x21, 0xe8, 0x62, 0x0d, 0x17, 0x20, 0x52, 0x19, 0x32, 0xa3, 0x26, 0x9a, 0x7a, 0x41, 0xbf,
+    0x04, 0x1d, 0x83, 0x3f, 0x6a, 0xa8, 0xeb, 0x85, 0xd2, 0x21, 0xfa, 0xc5, 0xd1, 0x31, 0x40, 0xed,
+    0x96, 0x1d, 0xa2, 0xc8, 0xc0, 0x11, 0x79, 0x8c, 0x33, 0x9a, 0x54, 0x72, 0x23, 0x93, 0x3c, 0x52,
+    0x31, 0xb3, 0xa9, 0x43, 0x23, 0x60, 0xd3, 0x04, 0x26, 0x41, 0x20, 0x13, 0x6a, 0x0e, 0x1d, 0x84,
+    0xc3, 0x30, 0x05, 0xb8, 0x92, 0xce, 0x60, 0x4f, 0xc6, 0x24, 0x29, 0x54, 0xbd, 0x4b, 0x39, 0xd7,
+    0x0a, 0x4e, 0x5c, 0x1d, 0x28, 0xe0, 0xdf, 0xcb, 0x8c, 0x9a, 0xe5, 0xad, 0xa8, 0xdd, 0x98, 0x80,
+    0xf0, 0x8c, 0x8e, 0xc8, 0x28, 0x33, 0x06, 0x66, 0x21, 0x2b, 0xab, 0x63, 0xe8, 0xe8, 0xe3, 0x0b,
+    0x14, 0x0d, 0x63, 0x00, 0x26, 0x0c, 0xe5, 0xb2, 0xd4, 0x8f, 0xcd, 0x38, 0xdc, 0xd1, 0xea, 0x87,
+    0x43, 0xa6, 0x46, 0xfd, 0x40, 0x2d, 0x96, 0x86, 0x8b, 0x98, 0xd5, 0x53, 0x35, 0x07, 0x4c, 0x1f,
+    0x60, 0xca, 0xa0, 0xad, 0x02, 0x04, 0x1a, 0x73, 0x7a, 0x33, 0x64, 0x02, 0x46, 0x20, 0x95, 0xee,
+    0x09, 0xe1, 0x77, 0x62, 0x7e, 0x75, 0xce, 0xe3, 0x0f, 0x03, 0x0f, 0xa5, 0x7a, 0x17, 0x10, 0x27,
+    0x65, 0x26, 0xfa, 0x70, 0xd4, 0x25, 0x3c, 0xbe, 0x5e, 0x3a, 0xd6, 0x81, 0xd1, 0xf8, 0x15, 0xc3,
+    0xe0, 0xe3, 0x57, 0x21, 0x26, 0x2d, 0x46, 0x84, 0xc5, 0x80, 0x4a, 0x08, 0x7f, 0x17, 0x93, 0x02,
+    0x12, 0x68, 0x73, 0x23, 0x58, 0x18, 0x73, 0x9d, 0x08, 0x0a, 0xb3, 0x55, 0xc9, 0xfd, 0x8a, 0x78,
+    0x23, 0xa1, 0xa2, 0x4b, 0x8f, 0xec, 0x12, 0x0f, 0xdc, 0xc2, 0xbc, 0x7e, 0x3b, 0xf1, 0x5b, 0x3a,
+    0x7b, 0x21, 0xe0, 0x6f, 0xe4, 0x26, 0xf3, 0x02, 0xd0, 0xfe, 0xfa, 0x22, 0x8c, 0x04, 0x78, 0x08,
+    0xeb, 0x40, 0x68, 0xd4, 0x64, 0x22, 0x98, 0xef, 0xe5, 0x22, 0x60, 0x64, 0xcd, 0x7f, 0x38, 0x85,
+    0xe0, 0xb6, 0x35, 0x32, 0x1f, 0xd0, 0xf4, 0x27, 0xce, 0x44, 0x23, 0xcd, 0x67, 0xcb, 0x53, 0x4b,
+    0xbf, 0xbe, 0x79, 0x0f, 0x76, 0xf7, 0xbd, 0x83, 0xbd, 0xd3, 0xa3, 0xe3, 0xb7, 0xfb, 0xa0, 0xc2,
+    0xe6, 0x45, 0x33, 0xbb, 0xb2, 0xfb, 0x79, 0x7f, 0x1f, 0xee, 0x9f, 0x5a, 0x5e, 0x27, 0x27, 0xef,
+    0xe7, 0x3a, 0xd9, 0x1b, 0x0e, 0x1b, 0x5c, 0x58, 0x85, 0xce, 0xbd, 0x53, 0x88, 0xfa, 0x23, 0x08,
+    0xe9, 0x53, 0x35, 0xc7, 0xd9, 0x1d, 0x97, 0xbf, 0x32, 0x96, 0xec, 0x09, 0xb8, 0x3c, 0xee, 0x5d,
+    0x40, 0xab, 0x4a, 0x8a, 0xf2, 0xba, 0xaa, 0xa8, 0x46, 0x42, 0x69, 0x4c, 0x20, 0xcf, 0xa4, 0x5e,
+    0x10, 0x38, 0x13, 0x8a, 0xab, 0xdb, 0x12, 0x9f, 0x40, 0xe9, 0xdd, 0x48, 0x41, 0x8e, 0xc3, 0x92,
+    0x88, 0x7b, 0x78, 0xe0, 0x41, 0x40, 0x67, 0x1b, 0x82, 0x8e, 0x98, 0x28, 0xf9, 0x32, 0x8c, 0x12,
+    0x3a, 0x12, 0x0c, 0x07, 0x84, 0xc4, 0x5d, 0xf8, 0xb3, 0x3c, 0xc8, 0x36, 0x4b, 0xd2, 0xb4, 0x0a,
+    0x55, 0x86, 0x97, 0x62, 0xad, 0x28, 0x73, 0x38, 0x30, 0xd4, 0x6c, 0x80, 0x61, 0xa4, 0x95, 0x00,
+    0x97, 0xff, 0x16, 0x20, 0x11, 0x15, 0x82, 0xb0, 0x49, 0x42, 0x44, 0xad, 0xab, 0x3a, 0x2b, 0x78,
+    0xee, 0x00, 0x68, 0xc4, 0xfc, 0xde, 0x6e, 0x08, 0x95, 0xb6, 0x4b, 0x2a, 0x68, 0x44, 0x3e, 0x41,
+    0x43, 0xec, 0x5a, 0xec, 0xdf, 0xd0, 0x4c, 0xbb, 0x58, 0x68, 0x6e, 0x97, 0xcc, 0xce, 0x10, 0xa9,
+    0x8d, 0x2e, 0xfc, 0xe0, 0x08, 0x6d, 0x75, 0x4b, 0x0f, 0x8a, 0x9f, 0x9c, 0x60, 0x8a, 0x34, 0xb2,
+    0xa0, 0x74, 0x45, 0x33, 0x37, 0x8a, 0x1e, 0x6a, 0xf3, 0x7f, 0xcc, 0x53, 0xfb, 0xa4, 0x5c, 0xee,
+    0xde, 0x25, 0x75, 0x65, 0xd1, 0x5b, 0x2c, 0x2b, 0x16, 0xe5, 0xb2, 0x52, 0xd9, 0x0d, 0x28, 0x22,
+    0xa1, 0xce, 0x46, 0xda, 0xa4, 0x5c, 0x4e, 0xfc, 0x27, 0x01, 0x1a, 0xc0, 0x29, 0xa5, 0xef, 0xf3,
+    0x01, 0x05, 0xa5, 0x4b, 0x96, 0xdb, 0xc3, 0xa7, 0x51, 0xc4, 0xa0, 0xc1, 0x24, 0x8a, 0x4b, 0x68,
+    0x1e, 0x10, 0xfb, 0xc1, 0xe2, 0xa1, 0x1c, 0x51, 0xb9, 0xfa, 0x99, 0x3c, 0x1c, 0x1e, 0xbe, 0xfd,
+    0x8f, 0x9e, 0xc9, 0x5a, 0xf3, 0x58, 0x80, 0x55, 0xbf, 0xe9, 0x7d, 0x4c, 0x13, 0x64, 0x5d, 0xd5,
+    0xc5, 0x73, 0x8a, 0x4e, 0xe3, 0x8d, 0x5c, 0xf0, 0x39, 0xcf, 0xbb, 0x02, 0xaa, 0x16, 0x81, 0xcb,
+    0x1e, 0xdb, 0xfd, 0x87, 0x3f, 0xd7, 0xe0, 0x25, 0x96, 0x9a, 0x21, 0xd8, 0xb2, 0xb2, 0x94, 0x6d,
+    0xc3, 0x95, 0x75, 0xad, 0x17, 0x1d, 0x53, 0xb7, 0xdf, 0x6a, 0x68, 0xe6, 0x2e, 0xd9, 0xb1, 0x6f,
+    0xb5, 0xdc, 0xa1, 0x0e, 0xb8, 0x4a, 0x5a, 0xd8, 0x35, 0xe8, 0xc6, 0x53, 0xbf, 0x3a, 0xea, 0xb7,
+    0xfd, 0xdb, 0xc0, 0xce, 0xbb, 0x00, 0xd6, 0xc3, 0x0a, 0x3d, 0x37, 0x37, 0xd7, 0x7f, 0xf0, 0x31,
+    0x5f, 0x61, 0x6e, 0x4f, 0xce, 0x31, 0x94, 0xbc, 0x62, 0x60, 0xca, 0xb3, 0x74, 0xcb, 0x5b, 0x3d,
+    0x5c, 0x7b, 0x73, 0x41, 0x65, 0x9e, 0x98, 0xc0, 0xd8, 0x2c, 0x23, 0x85, 0xcc, 0xbb, 0xba, 0xdd,
+    0x9d, 0xa0, 0x76, 0x86, 0xc1, 0xe0, 0x02, 0x4c, 0xa7, 0x10, 0xae, 0xe7, 0x78, 0x0f, 0x61, 0xc6,
+    0xb9, 0xe5, 0x5b, 0x98, 0xa3, 0xd1, 0x98, 0xcb, 0x78, 0x04, 0x61, 0x91, 0x82, 0xfc, 0x15, 0x08,
+    0x76, 0xd6, 0xb3, 0x6b, 0x1b, 0x0a, 0x8b, 0x70, 0xe9, 0xd7, 0xd2, 0xac, 0x5f, 0xfe, 0xbb, 0xe2,
+    0x8b, 0xe3, 0xf5, 0xdc, 0x67, 0xff, 0x00, 0x36, 0xec, 0xb9, 0xb5, 0x86, 0x13, 0x00, 0x00,
+};
+
+static const WebAsset webAssets[] = {
+    {"/style.css", "text/css", "\"" WEB_ASSET_STYLE_CSS_VERSION "\"", webAssetStyleCss, sizeof(webAssetStyleCss)},
+    {"/app.js", "application/javascript", "\"" WEB_ASSET_APP_JS_VERSION "\"", webAssetAppJs, sizeof(webAssetAppJs)},
+};
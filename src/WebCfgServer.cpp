@@ -6,11 +6,12 @@
 #include "PreferencesKeys.h"
 #include "RestartReason.h"
 #include "NetworkDeviceType.h"
+#include "WebAssets.h"
+#include "WebCfgSettingFields.h"
 #ifdef CONFIG_SOC_SPIRAM_SUPPORTED
 #include "esp_psram.h"
 #endif
 
-const char css[] PROGMEM = ":root{--nc-font-sans:'Inter',-apple-system,BlinkMacSystemFont,'Segoe UI',Roboto,Oxygen,Ubuntu,Cantarell,'Open Sans','Helvetica Neue',sans-serif,'Apple Color Emoji','Segoe UI Emoji','Segoe UI Symbol';--nc-font-mono:Consolas,monaco,'Ubuntu Mono','Liberation Mono','Courier New',Courier,monospace;--nc-tx-1:#000;--nc-tx-2:#1a1a1a;--nc-bg-1:#fff;--nc-bg-2:#f6f8fa;--nc-bg-3:#e5e7eb;--nc-lk-1:#0070f3;--nc-lk-2:#0366d6;--nc-lk-tx:#fff;--nc-ac-1:#79ffe1;--nc-ac-tx:#0c4047}@media(prefers-color-scheme:dark){:root{--nc-tx-1:#fff;--nc-tx-2:#eee;--nc-bg-1:#000;--nc-bg-2:#111;--nc-bg-3:#222;--nc-lk-1:#3291ff;--nc-lk-2:#0070f3;--nc-lk-tx:#fff;--nc-ac-1:#7928ca;--nc-ac-tx:#fff}}*{margin:0;padding:0}img,input,option,p,table,textarea,ul{margin-bottom:1rem}button,html,input,select{font-family:var(--nc-font-sans)}body{margin:0 auto;max-width:750px;padding:2rem;border-radius:6px;overflow-x:hidden;word-break:normal;overflow-wrap:anywhere;background:var(--nc-bg-1);color:var(--nc-tx-2);font-size:1.03rem;line-height:1.5}::selection{background:var(--nc-ac-1);color:var(--nc-ac-tx)}h1,h2,h3,h4,h5,h6{line-height:1;color:var(--nc-tx-1);padding-top:.875rem}h1,h2,h3{color:var(--nc-tx-1);padding-bottom:2px;margin-bottom:8px;border-bottom:1px solid var(--nc-bg-2)}h4,h5,h6{margin-bottom:.3rem}h1{font-size:2.25rem}h2{font-size:1.85rem}h3{font-size:1.55rem}h4{font-size:1.25rem}h5{font-size:1rem}h6{font-size:.875rem}a{color:var(--nc-lk-1)}a:hover{color:var(--nc-lk-2) !important;}abbr{cursor:help}abbr:hover{cursor:help}a button,button,input[type=button],input[type=reset],input[type=submit]{font-size:1rem;display:inline-block;padding:6px 12px;text-align:center;text-decoration:none;white-space:nowrap;background:var(--nc-lk-1);color:var(--nc-lk-tx);border:0;border-radius:4px;box-sizing:border-box;cursor:pointer;color:var(--nc-lk-tx)}a button[disabled],button[disabled],input[type=button][disabled],input[type=reset][disabled],input[type=submit][disabled]{cursor:default;opacity:.5;cursor:not-allowed}.button:focus,.button:hover,button:focus,button:hover,input[type=button]:focus,input[type=button]:hover,input[type=reset]:focus,input[type=reset]:hover,input[type=submit]:focus,input[type=submit]:hover{background:var(--nc-lk-2)}table{border-collapse:collapse;width:100%}td,th{border:1px solid var(--nc-bg-3);text-align:left;padding:.5rem}th{background:var(--nc-bg-2)}tr:nth-child(even){background:var(--nc-bg-2)}textarea{max-width:100%}input,select,textarea{padding:6px 12px;margin-bottom:.5rem;background:var(--nc-bg-2);color:var(--nc-tx-2);border:1px solid var(--nc-bg-3);border-radius:4px;box-shadow:none;box-sizing:border-box}img{max-width:100%}td>input{margin-top:0;margin-bottom:0}td>textarea{margin-top:0;margin-bottom:0}td>select{margin-top:0;margin-bottom:0}.warning{color:red}@media only screen and (max-width:600px){.adapt td{display:block}.adapt input[type=text],.adapt input[type=password],.adapt input[type=submit],.adapt textarea,.adapt select{width:100%}.adapt td:has(input[type=checkbox]){text-align:center}.adapt input[type=checkbox]{width:1.5em;height:1.5em}.adapt table td:first-child{border-bottom:0}.adapt table td:last-child{border-top:0}#tblnav a li>span{max-width:140px}}#tblnav a{border:0;border-bottom:1px solid;display:block;font-size:1rem;font-weight:bold;padding:.6rem 0;line-height:1;color:var(--nc-tx-1);text-decoration:none;background:linear-gradient(to left,transparent 50%,rgba(255,255,255,0.4) 50%) right;background-size:200% 100%;transition:all .2s ease}#tblnav a{background:linear-gradient(to left,var(--nc-bg-2) 50%,rgba(255,255,255,0.4) 50%) right;background-size:200% 100%}#tblnav a:hover{background-position:left;transition:all .45s ease}#tblnav a:active{background:var(--nc-lk-1);transition:all .15s ease}#tblnav a li{list-style:none;padding:.5rem;display:inline-block;width:100%}#tblnav a li>span{float:right;text-align:right;margin-right:10px;color:#f70;font-weight:100;font-style:italic;display:block}.tdbtn{text-align:center;vertical-align:middle}.naventry{float:left;max-width:375px;width:100%}.tab-button.active{background-color: var(--nc-ac-1);color: var(--nc-ac-tx);font-weight: bold;}";
 extern bool timeSynced;
 
 WebCfgServer::WebCfgServer(NukiWrapper *nuki, NukiNetwork *network, Preferences *preferences)
@@ -25,6 +26,8 @@ WebCfgServer::WebCfgServer(NukiWrapper *nuki, NukiNetwork *network, Preferences
         Log->println(F("[ERROR] Failed to allocate memory for WebServer!"));
     }
     _hostname = _preferences->getString(preference_hostname, "");
+    _bypassProxy = _preferences->getString(preference_bypass_proxy, "");
+    _httpAuthType = _preferences->getInt(preference_http_auth_type, 0);
     String str = _preferences->getString(preference_cred_user, "");
     str = _preferences->getString(preference_cred_user, "");
     _allowRestartToPortal = (network->networkDeviceType() == NetworkDeviceType::WiFi);
@@ -41,8 +44,9 @@ WebCfgServer::WebCfgServer(NukiWrapper *nuki, NukiNetwork *network, Preferences
         const char *pass = str.c_str();
         memcpy(&_credPassword, pass, str.length());
 
-        if (_preferences->getInt(preference_http_auth_type, 0) == 2)
+        if (_httpAuthType == 2)
         {
+            _persistSessions = _preferences->getBool(preference_update_time, false);
             loadSessions();
         }
     }
@@ -56,41 +60,40 @@ WebCfgServer::~WebCfgServer()
     _webServer = nullptr;
 }
 
-bool WebCfgServer::isAuthenticated(WebServer *server)
+/**
+ * @brief Returns the value of the session cookie inside a Cookie header, nullptr if missing.
+ */
+static const char *sessionCookieValue(const String &cookieHeader)
+{
+    const char *value = strstr(cookieHeader.c_str(), "sessionId=");
+    return value != nullptr ? value + strlen("sessionId=") : nullptr;
+}
+
+/**
+ * @brief Returns the current unix time in us.
+ */
+static int64_t unixTimeUs()
 {
-    String cookieKey = "sessionId";
+    struct timeval time;
+    gettimeofday(&time, NULL);
+    return (int64_t)time.tv_sec * 1000000L + (int64_t)time.tv_usec;
+}
 
-    // Get all cookies as a string
+bool WebCfgServer::isAuthenticated(WebServer *server)
+{
     String cookieHeader = server->header("Cookie");
+    const char *cookie = sessionCookieValue(cookieHeader);
 
-    if (cookieHeader.length() > 0)
+    if (cookie != nullptr)
     {
-        // Search the cookie value
-        int startIndex = cookieHeader.indexOf(cookieKey + "=");
-        if (startIndex != -1)
+        bool expired;
+        if (_httpSessions.validate(cookie, unixTimeUs(), expired))
         {
-            startIndex += cookieKey.length() + 1; // Position after the equal sign
-            int endIndex = cookieHeader.indexOf(";", startIndex);
-            if (endIndex == -1)
-                endIndex = cookieHeader.length();
-
-            String cookie = cookieHeader.substring(startIndex, endIndex);
-
-            if (_httpSessions[cookie].is<JsonVariant>())
-            {
-                struct timeval time;
-                gettimeofday(&time, NULL);
-                int64_t time_us = (int64_t)time.tv_sec * 1000000L + (int64_t)time.tv_usec;
-
-                if (_httpSessions[cookie].as<signed long long>() > time_us)
-                {
-                    return true;
-                }
-                else
-                {
-                    Log->println(F("[DEBUG] Cookie found, but not valid anymore"));
-                }
-            }
+            return true;
+        }
+        if (expired)
+        {
+            Log->println(F("[DEBUG] Cookie found, but not valid anymore"));
         }
     }
     return false;
@@ -98,13 +101,13 @@ bool WebCfgServer::isAuthenticated(WebServer *server)
 
 int WebCfgServer::doAuthentication(WebServer *server)
 {
-    if (!_network->isApOpen() && _preferences->getString(preference_bypass_proxy, "") != "" && server->client().localIP().toString() == _preferences->getString(preference_bypass_proxy, ""))
+    if (!_network->isApOpen() && _bypassProxy.length() > 0 && server->client().localIP().toString() == _bypassProxy)
     {
         return 4;
     }
     else if (strlen(_credUser) > 0 && strlen(_credPassword) > 0)
     {
-        int savedAuthType = _preferences->getInt(preference_http_auth_type, 0);
+        int savedAuthType = _httpAuthType;
         if (savedAuthType == 2)
         {
             if (!isAuthenticated(server))
@@ -130,9 +133,15 @@ void WebCfgServer::initialize()
 {
     Log->println(F("[DEBUG] WebCfgServer initializing..."));
 
-    // Route für css Style
-    _webServer->on("/style.css", HTTP_GET, [this]()
-                   { sendCss(this->_webServer); });
+    // Static assets (gzipped, see web/)
+    for (const WebAsset &asset : webAssets)
+    {
+        _webServer->on(asset.path, HTTP_GET, [this, &asset]()
+                       { sendWebAsset(this->_webServer, asset); });
+    }
+
+    const char *headerKeys[] = {"Cookie", "If-None-Match"};
+    _webServer->collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
 
     _webServer->onNotFound([this]()
                            { redirect(this->_webServer, "/"); });
@@ -592,6 +601,7 @@ void WebCfgServer::handleClient()
         return;
     }
     _webServer->handleClient();
+    saveSessions();
 }
 
 void WebCfgServer::waitAndProcess(const bool blocking, const uint32_t duration)
@@ -612,16 +622,8 @@ void WebCfgServer::waitAndProcess(const bool blocking, const uint32_t duration)
 
 void WebCfgServer::buildAccLvlHtml(WebServer *server)
 {
-    String response;
-    reserveHtmlResponse(response,
-                        21, // Checkboxes
-                        0,  // Inputs
-                        0,  // Dropdowns
-                        0,  // Dropdown options
-                        0,  // Textareas
-                        0,  // Parameter rows
-                        4   // Buttons
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response);
 
@@ -677,16 +679,13 @@ void WebCfgServer::buildAccLvlHtml(WebServer *server)
 
     response += F("</form></body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
 void WebCfgServer::buildNukiConfigHtml(WebServer *server)
 {
-    String response;
-    reserveHtmlResponse(response,
-                        3, // Checkboxes
-                        9  // Inputs
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response);
 
@@ -724,23 +723,13 @@ void WebCfgServer::buildNukiConfigHtml(WebServer *server)
 
     response += F("</table><br><input type=\"submit\" name=\"submit\" value=\"Save\"></form></body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
 void WebCfgServer::buildAdvancedConfigHtml(WebServer *server)
 {
-    String response;
-    reserveHtmlResponse(response,
-                        14,  // Checkboxes
-                        10,  // Inputs
-                        0,   // Dropdowns
-                        0,   // Dropdown options
-                        0,   // Textareas
-                        2,   // Parameter rows
-                        0,   // Buttons
-                        0,   // menus
-                        1024 // JavaScript/CSS
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response);
     response += F("<form class=\"adapt\" method=\"post\" action=\"post\">");
@@ -796,45 +785,15 @@ void WebCfgServer::buildAdvancedConfigHtml(WebServer *server)
     response += F("</table><br><input type=\"submit\" name=\"submit\" value=\"Save\">");
     response += F("</form>");
 
-    response += F("<script>window.onload = function() {"
-                  "document.getElementById(\"inputmaxauthlog\").addEventListener(\"keyup\", calculate);"
-                  "document.getElementById(\"inputmaxkeypad\").addEventListener(\"keyup\", calculate);"
-                  "document.getElementById(\"inputmaxtimecontrol\").addEventListener(\"keyup\", calculate);"
-                  "document.getElementById(\"inputmaxauth\").addEventListener(\"keyup\", calculate);"
-                  "calculate(); };"
-                  "function calculate() {"
-                  "var auth = document.getElementById(\"inputmaxauth\").value;"
-                  "var authlog = document.getElementById(\"inputmaxauthlog\").value;"
-                  "var keypad = document.getElementById(\"inputmaxkeypad\").value;"
-                  "var timecontrol = document.getElementById(\"inputmaxtimecontrol\").value;"
-                  "var charbuf = 0, networktask = 0;"
-                  "var sizeauth = 300 * auth, sizeauthlog = 280 * authlog, sizekeypad = 350 * keypad, sizetimecontrol = 120 * timecontrol;"
-                  "charbuf = Math.max(sizeauth, sizeauthlog, sizekeypad, sizetimecontrol, 4096);"
-                  "charbuf = Math.min(charbuf, 65536);"
-                  "networktask = Math.max(4096 + charbuf, 8192);"
-                  "networktask = Math.min(networktask, 65536);"
-                  "document.getElementById(\"mincharbuffer\").innerHTML = charbuf;"
-                  "document.getElementById(\"minnetworktask\").innerHTML = networktask;"
-                  "}"
-                  "</script></html>");
-
-    server->send(200, F("text/html"), response);
+    response += F("<script>window.onload = initAdvancedConfig;</script></html>");
+
+    response.end();
 }
 
 void WebCfgServer::buildLoginHtml(WebServer *server)
 {
-    String response;
-    reserveHtmlResponse(response,
-                        1,  // Checkbox
-                        2,  // Input fields
-                        0,  // Dropdowns
-                        0,  // Dropdown options
-                        0,  // Textareas
-                        0,  // Parameter rows
-                        0,  // Buttons
-                        0,  // menus
-                        704 // JS/CSS bytes
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     response += F("<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">");
     response += F("<style>form{border:3px solid #f1f1f1; max-width: 400px;}");
@@ -857,23 +816,13 @@ void WebCfgServer::buildLoginHtml(WebServer *server)
     response += F("<label><input type=\"checkbox\" name=\"remember\"> Remember me</label></div>");
     response += F("</form></center></body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
 void WebCfgServer::buildConfirmHtml(WebServer *server, const String &message, uint32_t redirectDelay, bool redirect, String redirectTo)
 {
-    String response;
-    reserveHtmlResponse(response,
-                        0,  // Checkboxes
-                        0,  // Inputs
-                        0,  // Dropdowns
-                        0,  // Dropdown options
-                        0,  // Textareas
-                        0,  // Parameter rows
-                        0,  // Buttons
-                        0,  // menus
-                        352 // extra bytes for JS/CSS
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     String header;
     header.reserve(384);
@@ -896,11 +845,18 @@ void WebCfgServer::buildConfirmHtml(WebServer *server, const String &message, ui
     response += message;
     response += F("</body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
 void WebCfgServer::buildGetLogFileHtml(WebServer *server)
 {
+    if (server->hasArg("tail") || server->hasArg("since") || server->hasArg("level") || server->hasArg("grep") || server->hasArg("max"))
+    {
+        return buildLogQueryResponse(server);
+    }
+
+    Log->flush();
+
     if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
     {
         Log->println(F("LittleFS Mount Failed"));
@@ -908,21 +864,78 @@ void WebCfgServer::buildGetLogFileHtml(WebServer *server)
         return;
     }
 
-    File file = LittleFS.open("/" + String(LOGGER_FILENAME), "r");
+    File file = LittleFS.open("/" + Log->getFileName(), "r");
 
     if (!file || file.isDirectory())
     {
-        Log->printf(F("%s not found\n"), LOGGER_FILENAME);
+        Log->printf(F("%s not found\n"), Log->getFileName().c_str());
         server->send(404, F("text/plain"), F("Log file not found."));
         return;
     }
 
-    server->sendHeader(F("Content-Disposition"), F("attachment; filename=\"Log.txt\""));
+    if (Log->isBinaryFormat() && !server->hasArg("raw"))
+    {
+        // convert binary records to the JSON line format on the fly
+        server->sendHeader(F("Content-Disposition"), F("attachment; filename=\"Log.txt\""));
+        ChunkedResponse response(server);
+        response.begin(200, "application/octet-stream");
+
+        LogBinaryReader reader;
+        LogRecord record;
+        while (reader.next(file, record))
+        {
+            Logger::printJsonLine(response, record);
+        }
+        response.end();
+        file.close();
+        return;
+    }
+
+    server->sendHeader(F("Content-Disposition"), Log->isBinaryFormat() ? F("attachment; filename=\"Log.blog\"") : F("attachment; filename=\"Log.txt\""));
     server->streamFile(file, F("application/octet-stream"));
     file.close();
     return;
 }
 
+void WebCfgServer::buildLogQueryResponse(WebServer *server)
+{
+    LogQuery query;
+    String grep = server->arg("grep");
+
+    if (server->hasArg("tail"))
+    {
+        query.tail = server->arg("tail").toInt();
+    }
+    if (server->hasArg("since"))
+    {
+        query.sinceMs = (int64_t)server->arg("since").toInt() * 1000;
+    }
+    if (server->hasArg("level"))
+    {
+        String level = server->arg("level");
+        level.toUpperCase();
+        Logger::msgtype lvl = Log->stringToLevel(level);
+        query.minLevel = lvl != (Logger::msgtype)-1 ? (int)lvl : level.toInt();
+    }
+    if (grep.length() > 0)
+    {
+        query.grep = grep.c_str();
+    }
+    if (server->hasArg("max"))
+    {
+        query.maxBytes = std::min<size_t>(std::max<long>(server->arg("max").toInt(), 0), LOG_QUERY_MAX_BYTES);
+    }
+
+    ChunkedResponse response(server);
+    server->sendHeader(F("Cache-Control"), F("no-cache"));
+    response.begin(200, "text/plain");
+    if (!Log->query(query, response))
+    {
+        response.print(F("{\"error\":\"log file not available\"}\n"));
+    }
+    response.end();
+}
+
 void WebCfgServer::buildGetCoredumpFileHtml(WebServer *server)
 {
     if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
@@ -951,13 +964,8 @@ void WebCfgServer::buildGetCoredumpFileHtml(WebServer *server)
 
 void WebCfgServer::buildNetworkConfigHtml(WebServer *server)
 {
-    String response;
-    reserveHtmlResponse(response,
-                        3, // Checkboxes
-                        6, // Input fields
-                        1, // Dropdowns
-                        3  // Dropdown options
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response);
     response += F("<form class=\"adapt\" method=\"post\" action=\"post\">");
@@ -990,24 +998,14 @@ void WebCfgServer::buildNetworkConfigHtml(WebServer *server)
     response += F("</form>");
     response += F("</body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
 #ifndef CONFIG_IDF_TARGET_ESP32H2
 void WebCfgServer::buildConfigureWifiHtml(WebServer *server)
 {
-    String response;
-    reserveHtmlResponse(response,
-                        0,  // checkboxCount
-                        0,  // inputFieldCount
-                        0,  // dropdownCount
-                        0,  // dropdownOptionCountTotal
-                        0,  // textareaCount
-                        0,  // parameterRowCount
-                        0,  // buttonCount
-                        0,  // menus
-                        400 // extra Bytes
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response);
 
@@ -1021,7 +1019,7 @@ void WebCfgServer::buildConfigureWifiHtml(WebServer *server)
     response += F("<input type=\"submit\" value=\"Reboot\" /></form>");
     response += F("</form></body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 #endif
 
@@ -1050,18 +1048,8 @@ void WebCfgServer::buildCredHtml(WebServer *server)
     generateRandomString(randomstr3, 32, chars2, sizeof(chars2) - 1);
 
     // Build HTML response
-    String response;
-    reserveHtmlResponse(response,
-                        1,  // Checkbox
-                        11, // Input fields
-                        1,  // Dropdown
-                        3,  // Dropdown options
-                        0,  // Textareas
-                        0,  // Parameter rows
-                        2,  // Buttons
-                        0,  // menus
-                        896 // extra bytes
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response);
     response += F("<form id=\"credfrm\" class=\"adapt\" onsubmit=\"return testcreds();\" method=\"post\" action=\"post\">");
@@ -1090,17 +1078,6 @@ void WebCfgServer::buildCredHtml(WebServer *server)
 
     response += F("</table><br><input type=\"submit\" name=\"submit\" value=\"Save\"></form>");
 
-    // JavaScript validation
-    response += F("<script>function testcreds() {"
-                  "var input_user = document.getElementById(\"inputuser\").value;"
-                  "var input_pass = document.getElementById(\"inputpass\").value;"
-                  "var input_pass2 = document.getElementById(\"inputpass2\").value;"
-                  "var pattern = /^[ -~]*$/;"
-                  "if(input_user == '#' || input_user == '') { return true; }"
-                  "if (input_pass != input_pass2) { alert('Passwords do not match'); return false;}"
-                  "if(!pattern.test(input_user) || !pattern.test(input_pass)) { alert('Only non-unicode characters are allowed in username and password'); return false;}"
-                  "return true; }</script>");
-
     // Nuki Lock settings
     if (_nuki != nullptr)
     {
@@ -1131,23 +1108,13 @@ void WebCfgServer::buildCredHtml(WebServer *server)
 #endif
     response += F("</table><br><button type=\"submit\">OK</button></form></body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
 void WebCfgServer::buildLoggingHtml(WebServer *server)
 {
-    String response;
-    reserveHtmlResponse(response,
-                        1,   // Checkbox
-                        10,  // Input fields
-                        1,   // Dropdown
-                        6,   // Dropdown options
-                        0,   // Textareas
-                        0,   // Parameter rows
-                        2,   // Buttons
-                        0,   // menus
-                        1024 // extra bytes
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response);
     response += F("<form class=\"adapt\" method=\"post\" action=\"post\">");
@@ -1155,8 +1122,8 @@ void WebCfgServer::buildLoggingHtml(WebServer *server)
     response += F("<h3>Logging Configuration</h3>");
     response += F("<table>");
 
-    appendInputFieldRow(response, "LOGFILE", "Filename", LOGGER_FILENAME, 64, "readonly");
-    appendInputFieldRow(response, "LOGMSGLEN", "Max. message length (min 1, max 1024)", _preferences->getInt(preference_log_max_msg_len, 128), 6, "min='1' max='1024'");
+    appendInputFieldRow(response, "LOGFILE", "Filename", Log->getFileName().c_str(), 64, "readonly");
+    appendInputFieldRow(response, "LOGMSGLEN", "Max. message length (min 1, max 255)", _preferences->getInt(preference_log_max_msg_len, 128), 6, "min='1' max='255'");
     appendInputFieldRow(response, "LOGMAXSIZE", "Max. log file size (min 256KB, max 1024KB)", _preferences->getInt(preference_log_max_file_size, 256), 6, "min='256' max='1024'");
 
     // Log level dropdown
@@ -1169,6 +1136,7 @@ void WebCfgServer::buildLoggingHtml(WebServer *server)
         lvlOptions.emplace_back(key, label);
     }
     appendDropDownRow(response, "LOGLEVEL", "Log level for Nuki Bridge", String(_preferences->getInt(preference_log_level, 0)), lvlOptions);
+    appendCheckBoxRow(response, "LOGBINARY", "Compact binary log file", _preferences->getBool(preference_log_binary, false), "", "");
 
     appendCheckBoxRow(response, "LOGBCKENA", "Enable FTP log backup", _preferences->getBool(preference_log_backup_enabled, false), "", "");
     appendInputFieldRow(response, "LOGBCKSRV", "FTP Server", _preferences->getString(preference_log_backup_ftp_server, "").c_str(), 64, "");
@@ -1187,6 +1155,10 @@ void WebCfgServer::buildLoggingHtml(WebServer *server)
     response += F("onclick=\"window.open('/get?page=logfile'); return false;\" ");
     response += F("style=\"margin-right: 10px;\">Download Log</button>");
 
+    response += F("<button type=\"button\" title=\"Show the last 100 log lines\" ");
+    response += F("onclick=\"window.open('/get?page=logfile&tail=100'); return false;\" ");
+    response += F("style=\"margin-right: 10px;\">Last 100 Lines</button>");
+
     response += F("<button type=\"button\" title=\"Clear log file\" ");
     response += F("onclick=\"if(confirm('Really clear log file?')) window.open('/get?page=clearlog'); return false;\" ");
     response += F("style=\"margin-right: 10px;\">Clear Log</button>");
@@ -1198,23 +1170,13 @@ void WebCfgServer::buildLoggingHtml(WebServer *server)
     response += F("</form>");
     response += F("</body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
 void WebCfgServer::buildApiConfigHtml(WebServer *server)
 {
-    String response;
-    reserveHtmlResponse(response,
-                        1, // Checkbox
-                        1, // Input fields
-                        0, // Dropdown
-                        0, // Dropdown options
-                        0, // Textareas
-                        1, // Parameter rows
-                        1, // Buttons
-                        0, // menus
-                        0  // extra bytes
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response);
     response += F("<form class=\"adapt\" method=\"post\" action=\"post\">");
@@ -1223,6 +1185,7 @@ void WebCfgServer::buildApiConfigHtml(WebServer *server)
 
     appendCheckBoxRow(response, "APIENA", "Enable REST API", _preferences->getBool(preference_api_enabled, false), "", "");
     appendInputFieldRow(response, "APIPORT", "API Port", _preferences->getInt(preference_api_port, 8080), 6, "");
+    appendInputFieldRow(response, "APIEVTCLIENTS", "Max. event stream clients", _preferences->getInt(preference_api_event_clients, EVENT_STREAM_DEFAULT_CLIENTS), 2, "");
 
     const char *currentToken = _network->getApiToken();
 
@@ -1235,23 +1198,13 @@ void WebCfgServer::buildApiConfigHtml(WebServer *server)
 
     response += F("</table><br><input type=\"submit\" name=\"submit\" value=\"Save\"></form></body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
 void WebCfgServer::buildHARConfigHtml(WebServer *server)
 {
-    String response;
-    reserveHtmlResponse(response,
-                        1,   // Checkbox
-                        60,  // Input fields
-                        2,   // Dropdown
-                        4,   // Dropdown options
-                        0,   // Textareas
-                        0,   // Parameter rows
-                        0,   // Buttons
-                        0,   // menus
-                        2048 // extra bytes
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response);
     response += F("<form class=\"adapt\" method=\"post\" action=\"post\">");
@@ -1269,6 +1222,9 @@ void WebCfgServer::buildHARConfigHtml(WebServer *server)
     // REST method selection (default GET)
     std::vector<std::pair<String, String>> restOptions = {{"0", "GET"}, {"1", "POST"}};
     appendDropDownRow(response, "HARRESTMODE", "REST Request Method", String(_preferences->getInt(preference_har_rest_mode, 0)), restOptions, "", "RestModeRow");
+    appendCheckBoxRow(response, "HARKEEPALIVE", "REST Keep connection alive", _preferences->getBool(preference_har_rest_keep_alive, true), "", "RestKeepAliveRow");
+    appendCheckBoxRow(response, "HARJSON", "Send Key Turner State and Battery Report as one JSON document", _preferences->getBool(preference_har_json_enabled, false), "", "");
+    appendInputFieldRow(response, "HARJSONPATH", "JSON Path (REST)", _preferences->getString(preference_har_json_path, "").c_str(), 64, "");
 
     appendInputFieldRow(response, "HARUSER", "Username", _preferences->getString(preference_har_user, "").c_str(), 32, "");
     appendInputFieldRow(response, "HARPASS", "Password", _preferences->getString(preference_har_password, "").c_str(), 32, "", true, true);
@@ -1362,79 +1318,17 @@ void WebCfgServer::buildHARConfigHtml(WebServer *server)
 
     response += F("<br><input type=\"submit\" name=\"submit\" value=\"Save\"></form>");
 
-    response += F("<script>"
-                  "function showTab(tab) {");
-    response += F("['");
-    response += F(HAR_CAT_GENERAL);
-    response += F("','");
-    response += F(HAR_CAT_KEY_TURN_STATE);
-    response += F("','");
-    response += F(HAR_CAT_BATTERY_REPORT);
-    response += F("']");
-    response += F(".forEach((id, idx) => {"
-                  "document.getElementById('tab_'+id).style.display=(id===tab)?'block':'none';"
-                  "document.querySelectorAll('.tab-button')[idx].classList.toggle('active',id===tab);"
-                  "});"
-                  "}"
-                  "function updateHarFields(){"
-                  "var m=document.getElementsByName('HARMODE')[0].value;"
-                  "var u=document.getElementsByName('HARUSER')[0];"
-                  "var p=document.getElementsByName('HARPASS')[0];"
-                  "var r=document.getElementById('RestModeRow');"
-                  "var k=document.querySelectorAll('.key-row');"
-                  "var pl=document.querySelectorAll('.param-label');"
-                  "u.disabled=p.disabled=(m==='0');"
-                  "r.style.display=(m==='0')?'none':'';"
-                  "k.forEach(e=>e.style.display=(m==='0')?'none':'');"
-                  "pl.forEach(l=>{l.innerHTML=l.innerHTML.replace(/:.*$/,m==='0'?'Param:':'Query:');});}"
-                  "document.getElementsByName('HARMODE')[0].addEventListener('change', updateHarFields);"
-                  "window.addEventListener('load',()=>{updateHarFields();showTab('general');});"
-                  "</script></body></html>");
-
-    server->send(200, F("text/html"), response);
+    response += F("<script>window.onload = initHarConfig;</script></body></html>");
+
+    response.end();
 }
 
 void WebCfgServer::buildHtml(WebServer *server)
 {
-    String header = F(
-        "<script>"
-        "let intervalId;"
-        "window.onload = function() {"
-        "updateInfo();"
-        "intervalId = setInterval(updateInfo, 3000);"
-        "};"
-        "function updateInfo() {"
-        "var request = new XMLHttpRequest();"
-        "request.open('GET', '/get?page=status', true);"
-        "request.onload = () => {"
-        "const obj = JSON.parse(request.responseText);"
-        "if (obj.stop == 1) {"
-        "clearInterval(intervalId);"
-        "}"
-        "for (var key of Object.keys(obj)) {"
-        "if (key == 'ota' && document.getElementById(key) !== null) {"
-        "document.getElementById(key).innerText = \"<a href='/ota'>\" + obj[key] + \"</a>\";"
-        "} else if (document.getElementById(key) !== null) {"
-        "document.getElementById(key).innerText = obj[key];"
-        "}"
-        "}"
-        "};"
-        "request.send();"
-        "}"
-        "</script>");
-
-    String response;
-    reserveHtmlResponse(response,
-                        0,              // Checkbox
-                        0,              // Input fields
-                        0,              // Dropdown
-                        0,              // Dropdown options
-                        0,              // Textareas
-                        7,              // Parameter rows
-                        0,              // Buttons
-                        14,             // Naviagtion menus
-                        header.length() // extra bytes ()
-    );
+    String header = F("<script>window.onload = initStatus;</script>");
+
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response, header);
 
@@ -1530,14 +1424,14 @@ void WebCfgServer::buildHtml(WebServer *server)
     appendNavigationMenuEntry(response, "Shutdown", "/get?page=shutdown", "return confirm('Really Shutdown Nuki Bridge?');");
 
 
-    if (_preferences->getInt(preference_http_auth_type, 0) == 2)
+    if (_httpAuthType == 2)
     {
         appendNavigationMenuEntry(response, "Logout", "/get?page=logout");
     }
 
     response += F("</ul></body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
 #ifndef CONFIG_IDF_TARGET_ESP32H2
@@ -1546,18 +1440,8 @@ void WebCfgServer::buildSSIDListHtml(WebServer *server)
     _network->scan(true, false);
     createSsidList();
 
-    String response;
-    reserveHtmlResponse(response,
-                        0,                     // Checkbox
-                        0,                     // Input fields
-                        0,                     // Dropdown
-                        0,                     // Dropdown options
-                        0,                     // Textareas
-                        0,                     // Parameter rows
-                        0,                     // Buttons
-                        0,                     // Naviagtion menus
-                        _ssidList.size() * 160 // extra bytes ()
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     for (size_t i = 0; i < _ssidList.size(); i++)
     {
@@ -1570,7 +1454,7 @@ void WebCfgServer::buildSSIDListHtml(WebServer *server)
         response += F(" %)</td></tr>");
     }
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 #endif
 
@@ -1579,50 +1463,13 @@ void WebCfgServer::buildConnectHtml(WebServer *server)
     const int currentHw = _preferences->getInt(preference_network_hardware, 1);
     auto hwOptions = getNetworkDetectionOptions();
 
-    String header = F("<style>.trssid:hover { cursor: pointer; color: blue; }</style>"
-                      "<script>"
-                      "let intervalId = null;"
-                      "function updateSSID() {"
-                      "var request = new XMLHttpRequest();"
-                      "request.open('GET', '/ssidlist', true);"
-                      "request.onload = () => {"
-                      "const aplist = document.getElementById(\"aplist\");"
-                      "if (aplist !== null) { aplist.innerHTML = request.responseText; }"
-                      "};"
-                      "request.send();"
-                      "}"
-                      "function startScan() {"
-                      "if (!intervalId) { intervalId = setInterval(updateSSID, 5000); }"
-                      "}"
-                      "function stopScan() {"
-                      "if (intervalId) { clearInterval(intervalId); intervalId = null; }"
-                      "}"
-                      "function toggleMode() {"
-                      "const isWifi = document.getElementById('nwmode').value === '1';"
-                      "document.getElementById('wlanConfig').style.display = isWifi ? 'block' : 'none';"
-                      "document.getElementById('inputssid').disabled = !isWifi;"
-                      "document.getElementById('inputpass').disabled = !isWifi;"
-                      "document.getElementById('cbfindbestrssi').disabled = !isWifi;"
-                      "if (isWifi) { startScan(); updateSSID(); } else { stopScan(); }"
-                      "}"
-                      "window.onload = function() { toggleMode(); if (document.getElementById('nwmode').value === '1') { updateSSID(); } };"
-                      "</script>");
+    String header = F("<script>window.onload = toggleMode;</script>");
 
     if (currentHw == 1)
         createSsidList();
 
-    String response;
-    reserveHtmlResponse(response,
-                        2,                                         // Checkbox
-                        7,                                         // Input fields
-                        1,                                         // Dropdown
-                        hwOptions.size(),                          // Dropdown options
-                        0,                                         // Textareas
-                        0,                                         // Parameter rows
-                        2,                                         // Buttons
-                        0,                                         // Navigation menus
-                        (_ssidList.size() * 160) + header.length() // extra content
-    );
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response, header);
 
@@ -1667,7 +1514,7 @@ void WebCfgServer::buildConnectHtml(WebServer *server)
     response += F("<input type=\"submit\" value=\"Reboot\" />");
     response += F("</form></body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
 void WebCfgServer::buildInfoHtml(WebServer *server)
@@ -1676,8 +1523,8 @@ void WebCfgServer::buildInfoHtml(WebServer *server)
     uint32_t aclPrefs[17];
     _preferences->getBytes(preference_acl, &aclPrefs, sizeof(aclPrefs));
 
-    String response;
-    response.reserve(12288);
+    ChunkedResponse response(server);
+    response.begin(200, "text/html");
 
     buildHtmlHeader(response);
     response += F("<h3>System Information</h3><pre>");
@@ -1726,7 +1573,9 @@ void WebCfgServer::buildInfoHtml(WebServer *server)
     response += F("\nMax message length: ");
     response += String(_preferences->getInt(preference_log_max_msg_len), 128);
     response += F("\nFilename: ");
-    response += LOGGER_FILENAME;
+    response += Log->getFileName();
+    response += F("\nBinary format: ");
+    response += Log->isBinaryFormat() ? F("Yes") : F("No");
     response += F("\nLevel: ");
     response += Log->levelToString(Log->getLevel());
     response += F("\nCurrent file size: ");
@@ -1905,6 +1754,10 @@ void WebCfgServer::buildInfoHtml(WebServer *server)
     response += _preferences->getString(preference_har_password).length() > 0 ? F("***") : F("Not set");
     response += F("\nHAR mode: ");
     response += _preferences->getString(preference_har_mode, F("Not set"));
+    response += F("\nHAR REST keep-alive: ");
+    response += _preferences->getBool(preference_har_rest_keep_alive, true) ? F("Yes") : F("No");
+    response += F("\nHAR JSON bulk report: ");
+    response += _preferences->getBool(preference_har_json_enabled, false) ? F("Yes") : F("No");
 
     // Bluetooth Infos
     response += F("\n\n------------ BLUETOOTH ------------");
@@ -2141,10 +1994,10 @@ void WebCfgServer::buildInfoHtml(WebServer *server)
 
     response += F("</pre></body></html>");
 
-    server->send(200, F("text/html"), response);
+    response.end();
 }
 
-void WebCfgServer::buildHtmlHeader(String &response, const String &additionalHeader)
+void WebCfgServer::buildHtmlHeader(ChunkedResponse &response, const String &additionalHeader)
 {
     response += F("<html><head>");
     response += F("<meta name='viewport' content='width=device-width, initial-scale=1'>");
@@ -2154,7 +2007,9 @@ void WebCfgServer::buildHtmlHeader(String &response, const String &additionalHea
         response += additionalHeader;
     }
 
-    response += F("<link rel='stylesheet' href='/style.css'>");
+    // the version query makes browsers fetch changed assets after a firmware update
+    response += F("<link rel='stylesheet' href='/style.css?v=" WEB_ASSET_STYLE_CSS_VERSION "'>");
+    response += F("<script src='/app.js?v=" WEB_ASSET_APP_JS_VERSION "'></script>");
     response += F("<title>Nuki Bridge</title></head><body>");
 }
 
@@ -2231,7 +2086,7 @@ void WebCfgServer::buildStatusHtml(WebServer *server)
     return server->send(200, F("application/json"), jsonStr.c_str());
 }
 
-void WebCfgServer::appendNavigationMenuEntry(String &response, const char *title, const char *targetPath, const char *warningMessage)
+void WebCfgServer::appendNavigationMenuEntry(ChunkedResponse &response, const char *title, const char *targetPath, const char *warningMessage)
 {
     response += F("<a class=\"naventry\" href=\"");
     response += targetPath;
@@ -2248,7 +2103,7 @@ void WebCfgServer::appendNavigationMenuEntry(String &response, const char *title
     response += F("</li></a>");
 }
 
-void WebCfgServer::appendParameterRow(String &response, const char *description, const char *value, const char *link, const char *id)
+void WebCfgServer::appendParameterRow(ChunkedResponse &response, const char *description, const char *value, const char *link, const char *id)
 {
     response += F("<tr><td>");
     response += description;
@@ -2281,7 +2136,7 @@ void WebCfgServer::appendParameterRow(String &response, const char *description,
     response += F("</td></tr>");
 }
 
-void WebCfgServer::appendInputFieldRow(String &response,
+void WebCfgServer::appendInputFieldRow(ChunkedResponse &response,
                                        const char *token,
                                        const char *description,
                                        const char *value,
@@ -2327,7 +2182,7 @@ void WebCfgServer::appendInputFieldRow(String &response,
     response += F("\"/></td></tr>");
 }
 
-void WebCfgServer::appendInputFieldRow(String &response,
+void WebCfgServer::appendInputFieldRow(ChunkedResponse &response,
                                        const char *token,
                                        const char *description,
                                        const int value,
@@ -2339,7 +2194,7 @@ void WebCfgServer::appendInputFieldRow(String &response,
     appendInputFieldRow(response, token, description, valueStr, maxLength, args);
 }
 
-void WebCfgServer::appendDropDownRow(String &response,
+void WebCfgServer::appendDropDownRow(ChunkedResponse &response,
                                      const char *token,
                                      const char *description,
                                      const String preselectedValue,
@@ -2393,7 +2248,7 @@ void WebCfgServer::appendDropDownRow(String &response,
     response += F("</td></tr>");
 }
 
-void WebCfgServer::appendTextareaRow(String &response,
+void WebCfgServer::appendTextareaRow(ChunkedResponse &response,
                                      const char *token,
                                      const char *description,
                                      const char *value,
@@ -2426,7 +2281,7 @@ void WebCfgServer::appendTextareaRow(String &response,
     response += F("</textarea></td></tr>");
 }
 
-void WebCfgServer::appendCheckBoxRow(String &response,
+void WebCfgServer::appendCheckBoxRow(ChunkedResponse &response,
                                      const char *token,
                                      const char *description,
                                      const bool value,
@@ -2483,14 +2338,20 @@ const std::vector<std::pair<String, String>> WebCfgServer::getNetworkDetectionOp
     return options;
 }
 
-void WebCfgServer::sendCss(WebServer *server)
+void WebCfgServer::sendWebAsset(WebServer *server, const WebAsset &asset)
 {
-    // Setze den Cache-Control Header
-    server->sendHeader(F("Cache-Control"), "public, max-age=3600");
+    server->sendHeader(F("Cache-Control"), F("public, max-age=3600"));
+    server->sendHeader(F("ETag"), asset.etag);
+
+    if (server->header("If-None-Match") == asset.etag)
+    {
+        server->send(304);
+        return;
+    }
 
-    // Setze den Content-Type auf text/css
-    server->setContentLength(CONTENT_LENGTH_UNKNOWN); // Länge muss nicht im Voraus bekannt sein
-    server->send(200, F("text/css"), css);            // Antwortstatus 200 und Content-Type "text/css"
+    // all browsers accept gzip, the assets are only stored compressed
+    server->sendHeader(F("Content-Encoding"), F("gzip"));
+    server->send_P(200, asset.contentType, (const char *)asset.data, asset.size);
 }
 
 String WebCfgServer::generateConfirmCode()
@@ -2499,84 +2360,44 @@ String WebCfgServer::generateConfirmCode()
     return String(code);
 }
 
-size_t WebCfgServer::estimateHtmlSize(
-    int checkboxCount,
-    int inputFieldCount,
-    int dropdownCount,
-    int dropdownOptionCountTotal,
-    int textareaCount,
-    int parameterRowCount,
-    int buttonCount,
-    int navigationMenuCount,
-    int extraContentBytes)
+bool WebCfgServer::applySetting(const SettingField &field, const String &value)
 {
-    const int checkboxSize = 320;
-    const int inputFieldSize = 368;
-    const int dropdownBaseSize = 192;
-    const int dropdownOptionSize = 96;
-    const int textareaSize = 384;
-    const int paramRowSize = 192;
-    const int buttonSize = 160;
-    const int navigationMenuSize = 160;
-    const int footerSize = 160;
-    const int headerSize = 368;
-    const int extraStatic = 160; // additional <input hidden> / <td> / <form> etc.
-
-    size_t total = headerSize + extraStatic + extraContentBytes + footerSize;
-    total += checkboxCount * checkboxSize;
-    total += inputFieldCount * inputFieldSize;
-    total += dropdownCount * dropdownBaseSize + dropdownOptionCountTotal * dropdownOptionSize;
-    total += textareaCount * textareaSize;
-    total += parameterRowCount * paramRowSize;
-    total += buttonCount * buttonSize;
-    total += navigationMenuCount * navigationMenuSize;
-
-    return total;
-}
+    switch (field.type)
+    {
+    case SettingType::String:
+        if (_preferences->getString(field.prefKey, "") == value)
+        {
+            return false;
+        }
+        _preferences->putString(field.prefKey, value);
+        return true;
 
-#define HANDLE_STRING_PREF_ARG(KEYNAME, PREFNAME, CONFIG_CHANGED) \
-    else if (key == KEYNAME)                                      \
-    {                                                             \
-        if (_preferences->getString(PREFNAME, "") != value)       \
-        {                                                         \
-            _preferences->putString(PREFNAME, value);             \
-            Log->print(F("[DEBUG] Setting changed: "));           \
-            Log->println(KEYNAME);                                \
-            if (CONFIG_CHANGED)                                   \
-            {                                                     \
-                configChanged = true;                             \
-            }                                                     \
-        }                                                         \
+    case SettingType::Bool:
+    {
+        bool enabled = (value == "1");
+        if (_preferences->getBool(field.prefKey, field.defaultValue != 0) == enabled)
+        {
+            return false;
+        }
+        _preferences->putBool(field.prefKey, enabled);
+        return true;
     }
-#define HANDLE_BOOL_PREF_ARG(KEYNAME, PREFNAME, CONFIG_CHANGED)       \
-    else if (key == KEYNAME)                                          \
-    {                                                                 \
-        if (_preferences->getBool(PREFNAME, false) != (value == "1")) \
-        {                                                             \
-            _preferences->putBool(PREFNAME, (value == "1"));          \
-            Log->print(F("[DEBUG] Setting changed: "));               \
-            Log->println(KEYNAME);                                    \
-            if (CONFIG_CHANGED)                                       \
-            {                                                         \
-                configChanged = true;                                 \
-            }                                                         \
-        }                                                             \
+
+    case SettingType::Int:
+    {
+        int32_t number = value.toInt();
+        if (number < field.min || number > field.max || _preferences->getInt(field.prefKey, field.defaultValue) == number)
+        {
+            return false;
+        }
+        _preferences->putInt(field.prefKey, number);
+        return true;
     }
 
-#define HANDLE_INT_PREF_ARG(KEYNAME, PREFNAME, CONFIG_CHANGED)  \
-    else if (key == KEYNAME)                                    \
-    {                                                           \
-        if (_preferences->getInt(PREFNAME, 0) != value.toInt()) \
-        {                                                       \
-            _preferences->putInt(PREFNAME, value.toInt());      \
-            Log->print(F("[DEBUG] Setting changed: "));         \
-            Log->println(KEYNAME);                              \
-            if (CONFIG_CHANGED)                                 \
-            {                                                   \
-                configChanged = true;                           \
-            }                                                   \
-        }                                                       \
+    default:
+        return false;
     }
+}
 
 bool WebCfgServer::processArgs(WebServer *server, String &message)
 {
@@ -2607,18 +2428,45 @@ bool WebCfgServer::processArgs(WebServer *server, String &message)
         String key = server->argName(i);
         String value = server->arg(i);
 
-        if (key == "HARHOST")
+        const SettingField *field = findSettingField(key.c_str());
+        if (field != nullptr)
         {
-            if (_preferences->getString(preference_har_address, "") != value)
+            switch (field->type)
             {
-                _preferences->putString(preference_har_address, value);
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
+            case SettingType::AclAction:
+                aclPrefs[field->defaultValue] = ((value == "1") ? 1 : 0);
+                break;
+            case SettingType::AclBasicLockConfig:
+                basicLockConfigAclPrefs[field->defaultValue] = ((value == "1") ? 1 : 0);
+                break;
+            case SettingType::AclAdvancedLockConfig:
+                advancedLockConfigAclPrefs[field->defaultValue] = ((value == "1") ? 1 : 0);
+                break;
+            default:
+                if (applySetting(*field, value))
+                {
+                    Log->print(F("[DEBUG] Setting changed: "));
+                    Log->println(key);
+                    if (field->flags & SETTING_RESTART)
+                    {
+                        configChanged = true;
+                    }
+                    if (field->flags & SETTING_NETWORK)
+                    {
+                        networkReconfigure = true;
+                    }
+                    if (field->flags & SETTING_SESSION)
+                    {
+                        clearSession = true;
+                    }
+                }
+                break;
             }
+            continue;
         }
-        HANDLE_INT_PREF_ARG("HARPORT", preference_har_port, true)
-        else if (key == "HARUSER")
+
+        // fields with side effects
+        if (key == "HARUSER")
         {
             if (value == "#")
             {
@@ -2635,7 +2483,6 @@ bool WebCfgServer::processArgs(WebServer *server, String &message)
                 }
             }
         }
-        HANDLE_STRING_PREF_ARG("HARPASS", preference_har_password, true)
         else if (key == "HARENA")
         {
             if (_preferences->getBool(preference_har_enabled, false) != (value == "1"))
@@ -2661,71 +2508,6 @@ bool WebCfgServer::processArgs(WebServer *server, String &message)
                 configChanged = true;
             }
         }
-        HANDLE_STRING_PREF_ARG("HARRESTMODE", preference_har_rest_mode, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_STAT, preference_har_key_state, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_REMACCSTAT, preference_har_key_remote_access_state, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_REMACCSTAT, preference_har_param_remote_access_state, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_WFRSSI, preference_har_key_wifi_rssi, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_WFRSSI, preference_har_param_wifi_rssi, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_UPTM, preference_har_key_uptime, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_UPTM, preference_har_param_uptime, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_RSTFW, preference_har_key_restart_reason_fw, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_RSTFW, preference_har_param_restart_reason_fw, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_RSTESP, preference_har_key_restart_reason_esp, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_RSTESP, preference_har_param_restart_reason_esp, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_NBVER, preference_har_key_info_nuki_bridge_version, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_NBVER, preference_har_param_info_nuki_bridge_version, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_NBBUILD, preference_har_key_info_nuki_bridge_build, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_NBBUILD, preference_har_param_info_nuki_bridge_build, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_FREEHP, preference_har_key_freeheap, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_FREEHP, preference_har_param_freeheap, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_BLEADDR, preference_har_key_ble_address, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_BLEADDR, preference_har_param_ble_address, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_BLESTR, preference_har_key_ble_strength, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_BLESTR, preference_har_param_ble_strength, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_BLERSSI, preference_har_key_ble_rssi, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_BLERSSI, preference_har_param_ble_rssi, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_LCKSTAT, preference_har_key_lock_state, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_LCKSTAT, preference_har_param_lock_state, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_LCKNGOSTAT, preference_har_key_lockngo_state, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_LCKNGOSTAT, preference_har_param_lockngo_state, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_LCKTRIG, preference_har_key_lock_trigger, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_LCKTRIG, preference_har_param_lock_trigger, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_LCKNMOD, preference_har_key_lock_night_mode, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_LCKNMOD, preference_har_param_lock_night_mode, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_LCKCMPLSTAT, preference_har_key_lock_completionStatus, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_LCKCMPLSTAT, preference_har_param_lock_completionStatus, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_DOORSTAT, preference_har_key_doorsensor_state, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_DOORSTAT, preference_har_param_doorsensor_state, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_DOORSCRIT, preference_har_key_doorsensor_critical, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_DOORSCRIT, preference_har_param_doorsensor_critical, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_KPCRIT, preference_har_key_keypad_critical, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_KPCRIT, preference_har_param_keypad_critical, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_LCKBATCRIT, preference_har_key_lock_battery_critical, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_LCKBATCRIT, preference_har_param_lock_battery_critical, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_LCKBATLVL, preference_har_key_lock_battery_level, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_LCKBATLVL, preference_har_param_lock_battery_level, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_LCKBATCHRG, preference_har_key_lock_battery_charging, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_LCKBATCHRG, preference_har_param_lock_battery_charging, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_BATVOLT, preference_har_key_battery_voltage, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_BATVOLT, preference_har_param_battery_voltage, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_BATDRAIN, preference_har_key_battery_drain, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_BATDRAIN, preference_har_param_battery_drain, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_BATMAXTURNCUR, preference_har_key_battery_max_turn_current, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_BATMAXTURNCUR, preference_har_param_battery_max_turn_current, true)
-        HANDLE_STRING_PREF_ARG("KEY_" TOKEN_SUFFIX_BATLCKDIST, preference_har_key_battery_lock_distance, true)
-        HANDLE_STRING_PREF_ARG("PARAM_" TOKEN_SUFFIX_BATLCKDIST, preference_har_param_battery_lock_distance, true)
-        else if (key == "UPTIME")
-        {
-            if (_preferences->getBool(preference_update_time, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_update_time, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        HANDLE_STRING_PREF_ARG("TIMESRV", preference_time_server, true)
         else if (key == "NWHW")
         {
             if (_preferences->getInt(preference_network_hardware, 0) != value.toInt())
@@ -2744,938 +2526,177 @@ bool WebCfgServer::processArgs(WebServer *server, String &message)
                 configChanged = true;
             }
         }
-        else if (key == "NWCUSTPHY")
+        else if (key == "LOGBCKENA")
         {
-            if (_preferences->getInt(preference_network_custom_phy, 0) != value.toInt())
+            if (_preferences->getBool(preference_log_backup_enabled, false) != (value == "1"))
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_phy, value.toInt());
+                Log->disableBackup();
+                _preferences->putBool(preference_log_backup_enabled, (value == "1"));
                 Log->print(F("[DEBUG] Setting changed: "));
                 Log->println(key);
                 configChanged = true;
             }
         }
-        else if (key == "NWCUSTADDR")
+        else if (key == "LOGLEVEL")
         {
-            if (_preferences->getInt(preference_network_custom_addr, -1) != value.toInt())
+            if (_preferences->getInt(preference_log_level, 0) != value.toInt())
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_addr, value.toInt());
+                if (value.toInt() >= 0 && value.toInt() <= 5)
+                {
+                    Log->setLevel((Logger::msgtype)value.toInt());
+                }
+                _preferences->putInt(preference_log_level, value.toInt());
                 Log->print(F("[DEBUG] Setting changed: "));
                 Log->println(key);
-                configChanged = true;
+                // configChanged = true;
             }
         }
-        else if (key == "NWCUSTIRQ")
+        else if (key == "APIENA")
         {
-            if (_preferences->getInt(preference_network_custom_irq, 0) != value.toInt())
+            if (_preferences->getBool(preference_api_enabled, false) != (value == "1"))
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_irq, value.toInt());
+                _network->disableAPI();
+                _preferences->putBool(preference_api_enabled, (value == "1"));
                 Log->print(F("[DEBUG] Setting changed: "));
                 Log->println(key);
                 configChanged = true;
             }
         }
-        else if (key == "NWCUSTRST")
+        else if (key == "HOSTNAME")
         {
-            if (_preferences->getInt(preference_network_custom_rst, 0) != value.toInt())
+            if (_preferences->getString(preference_hostname, "") != value && value != "nukirestbridge")
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_rst, value.toInt());
+                _preferences->putString(preference_hostname, value);
                 Log->print(F("[DEBUG] Setting changed: "));
                 Log->println(key);
                 configChanged = true;
             }
         }
-        else if (key == "NWCUSTCS")
+        else if (key == "TXPWR")
         {
-            if (_preferences->getInt(preference_network_custom_cs, 0) != value.toInt())
+#if defined(CONFIG_IDF_TARGET_ESP32)
+            if (value.toInt() >= -12 && value.toInt() <= 9)
+#else
+            if (value.toInt() >= -12 && value.toInt() <= 20)
+#endif
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_cs, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
+                if (_preferences->getInt(preference_ble_tx_power, 9) != value.toInt())
+                {
+                    _preferences->putInt(preference_ble_tx_power, value.toInt());
+                    Log->print(F("[DEBUG] Setting changed: "));
+                    Log->println(key);
+                    // configChanged = true;
+                }
             }
         }
-        else if (key == "NWCUSTSCK")
+        else if (key == "ACLLVLCHANGED")
         {
-            if (_preferences->getInt(preference_network_custom_sck, 0) != value.toInt())
-            {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_sck, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
+            aclLvlChanged = true;
         }
-        else if (key == "NWCUSTMISO")
+        else if (key == "CREDDIGEST")
         {
-            if (_preferences->getInt(preference_network_custom_miso, 0) != value.toInt())
+            if (_preferences->getInt(preference_http_auth_type, 0) != value.toInt())
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_miso, value.toInt());
+                _preferences->putInt(preference_http_auth_type, value.toInt());
+                _httpAuthType = value.toInt();
                 Log->print(F("[DEBUG] Setting changed: "));
                 Log->println(key);
                 configChanged = true;
+                clearSession = true;
             }
         }
-        else if (key == "NWCUSTMOSI")
+        else if (key == "CREDTRUSTPROXY")
         {
-            if (_preferences->getInt(preference_network_custom_mosi, 0) != value.toInt())
+            if (value != "*")
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_mosi, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
+                if (_preferences->getString(preference_bypass_proxy, "") != value)
+                {
+                    _preferences->putString(preference_bypass_proxy, value);
+                    _bypassProxy = value;
+                    Log->print(F("[DEBUG] Setting changed: "));
+                    Log->println(key);
+                    configChanged = true;
+                    clearSession = true;
+                }
             }
         }
-        else if (key == "NWCUSTPWR")
+        else if (key == "CREDUSER")
         {
-            if (_preferences->getInt(preference_network_custom_pwr, 0) != value.toInt())
+            if (value == "#")
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_pwr, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
+                clearCredentials = true;
             }
-        }
-        else if (key == "NWCUSTMDIO")
-        {
-            if (_preferences->getInt(preference_network_custom_mdio, 0) != value.toInt())
+            else
             {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_mdio, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
+                if (_preferences->getString(preference_cred_user, "") != value)
+                {
+                    _preferences->putString(preference_cred_user, value);
+                    Log->print(F("[DEBUG] Setting changed: "));
+                    Log->println(key);
+                    configChanged = true;
+                    clearSession = true;
+                }
             }
         }
-        else if (key == "NWCUSTMDC")
+        else if (key == "CREDPASS")
         {
-            if (_preferences->getInt(preference_network_custom_mdc, 0) != value.toInt())
-            {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_mdc, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
+            pass1 = value;
         }
-        else if (key == "NWCUSTCLK")
+        else if (key == "CREDPASSRE")
         {
-            if (_preferences->getInt(preference_network_custom_clk, 0) != value.toInt())
-            {
-                networkReconfigure = true;
-                _preferences->putInt(preference_network_custom_clk, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
+            pass2 = value;
         }
-        else if (key == "RSSI")
+        else if (key == "CREDADMIN")
         {
-            if (_preferences->getInt(preference_rssi_send_interval, 60) != value.toInt())
+            if (value != "*")
             {
-                _preferences->putInt(preference_rssi_send_interval, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
+                if (_preferences->getString(preference_admin_secret, "") != value)
+                {
+                    _preferences->putString(preference_admin_secret, value);
+                    Log->print(F("[DEBUG] Setting changed: "));
+                    Log->println(key);
+                    configChanged = true;
+                }
             }
         }
-        else if (key == "CREDLFTM")
+        else if (key == "NUKIPIN" && _nuki != nullptr)
         {
-            if (_preferences->getInt(preference_cred_session_lifetime, 3600) != value.toInt())
+            if (value == "#")
             {
-                _preferences->putInt(preference_cred_session_lifetime, value.toInt());
+
+                message = "Nuki Lock PIN cleared";
+                _nuki->setPin(0xffff);
+
                 Log->print(F("[DEBUG] Setting changed: "));
                 Log->println(key);
                 configChanged = true;
-                clearSession = true;
             }
-        }
-        else if (key == "CREDLFTMRMBR")
-        {
-            if (_preferences->getInt(preference_cred_session_lifetime_remember, 720) != value.toInt())
+            else
             {
-                _preferences->putInt(preference_cred_session_lifetime_remember, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-                clearSession = true;
+
+                if (_nuki->getPin() != value.toInt())
+                {
+                    message = "Nuki Lock PIN saved";
+                    _nuki->setPin(value.toInt());
+                    Log->print(F("[DEBUG] Setting changed: "));
+                    Log->println(key);
+                    configChanged = true;
+                }
             }
         }
-
-        else if (key == "LOGBCKENA")
+        else if (key == "LCKMANPAIR" && (value == "1"))
         {
-            if (_preferences->getBool(preference_log_backup_enabled, false) != (value == "1"))
-            {
-                Log->disableBackup();
-                _preferences->putBool(preference_log_backup_enabled, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
+            manPairLck = true;
         }
-        else if (key == "LOGMSGLEN")
+        else if (key == "LCKBLEADDR")
         {
-            if (_preferences->getInt(preference_log_max_msg_len, 1) != value.toInt())
-            {
-                _preferences->putInt(preference_log_max_msg_len, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                // configChanged = true;
-            }
+            if (value.length() == 12)
+                for (int i = 0; i < value.length(); i += 2)
+                {
+                    currentBleAddress[(i / 2)] = std::stoi(value.substring(i, i + 2).c_str(), nullptr, 16);
+                }
         }
-        else if (key == "LOGMAXSIZE")
-        {
-            if (_preferences->getInt(preference_log_max_file_size, 256) != value.toInt())
-            {
-                _preferences->putInt(preference_log_max_file_size, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        HANDLE_STRING_PREF_ARG("LOGBCKSRV", preference_log_backup_ftp_server, true)
-        HANDLE_STRING_PREF_ARG("LOGBCKDIR", preference_log_backup_ftp_dir, true)
-        HANDLE_STRING_PREF_ARG("LOGBCKUSR", preference_log_backup_ftp_user, true)
-        HANDLE_STRING_PREF_ARG("LOGBCKPWD", preference_log_backup_ftp_pwd, true)
-        else if (key == "LOGLEVEL")
-        {
-            if (_preferences->getInt(preference_log_level, 0) != value.toInt())
-            {
-                if (value.toInt() >= 0 && value.toInt() <= 5)
-                {
-                    Log->setLevel((Logger::msgtype)value.toInt());
-                }
-                _preferences->putInt(preference_log_level, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "APIENA")
-        {
-            if (_preferences->getBool(preference_api_enabled, false) != (value == "1"))
-            {
-                _network->disableAPI();
-                _preferences->putBool(preference_api_enabled, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "APIPORT")
-        {
-            if (_preferences->getInt(preference_api_port, 0) != value.toInt())
-            {
-                _preferences->putInt(preference_api_port, value.toInt());
-                Log->print("Setting changed: ");
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "HOSTNAME")
-        {
-            if (_preferences->getString(preference_hostname, "") != value && value != "nukirestbridge")
-            {
-                _preferences->putString(preference_hostname, value);
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "NETTIMEOUT")
-        {
-            if (_preferences->getInt(preference_network_timeout, 60) != value.toInt())
-            {
-                _preferences->putInt(preference_network_timeout, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "FINDBESTRSSI")
-        {
-            if (_preferences->getBool(preference_find_best_rssi, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_find_best_rssi, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "RSTDISC")
-        {
-            if (_preferences->getBool(preference_restart_on_disconnect, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_restart_on_disconnect, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "DHCPENA")
-        {
-            if (_preferences->getBool(preference_ip_dhcp_enabled, true) != (value == "1"))
-            {
-                _preferences->putBool(preference_ip_dhcp_enabled, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "IPADDR")
-        {
-            if (_preferences->getString(preference_ip_address, "") != value)
-            {
-                _preferences->putString(preference_ip_address, value);
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "IPSUB")
-        {
-            if (_preferences->getString(preference_ip_subnet, "") != value)
-            {
-                _preferences->putString(preference_ip_subnet, value);
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "IPGTW")
-        {
-            if (_preferences->getString(preference_ip_gateway, "") != value)
-            {
-                _preferences->putString(preference_ip_gateway, value);
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "DNSSRV")
-        {
-            if (_preferences->getString(preference_ip_dns_server, "") != value)
-            {
-                _preferences->putString(preference_ip_dns_server, value);
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "LSTINT")
-        {
-            if (_preferences->getInt(preference_query_interval_lockstate, 1800) != value.toInt())
-            {
-                _preferences->putInt(preference_query_interval_lockstate, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "CFGINT")
-        {
-            if (_preferences->getInt(preference_query_interval_configuration, 3600) != value.toInt())
-            {
-                _preferences->putInt(preference_query_interval_configuration, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "BATINT")
-        {
-            if (_preferences->getInt(preference_query_interval_battery, 1800) != value.toInt())
-            {
-                _preferences->putInt(preference_query_interval_battery, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "KPINT")
-        {
-            if (_preferences->getInt(preference_query_interval_keypad, 1800) != value.toInt())
-            {
-                _preferences->putInt(preference_query_interval_keypad, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "NRTRY")
-        {
-            if (_preferences->getInt(preference_command_nr_of_retries, 3) != value.toInt())
-            {
-                _preferences->putInt(preference_command_nr_of_retries, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "TRYDLY")
-        {
-            if (_preferences->getInt(preference_command_retry_delay, 100) != value.toInt())
-            {
-                _preferences->putInt(preference_command_retry_delay, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "TXPWR")
-        {
-#if defined(CONFIG_IDF_TARGET_ESP32)
-            if (value.toInt() >= -12 && value.toInt() <= 9)
-#else
-            if (value.toInt() >= -12 && value.toInt() <= 20)
-#endif
-            {
-                if (_preferences->getInt(preference_ble_tx_power, 9) != value.toInt())
-                {
-                    _preferences->putInt(preference_ble_tx_power, value.toInt());
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    // configChanged = true;
-                }
-            }
-        }
-        else if (key == "RSBC")
-        {
-            if (_preferences->getInt(preference_restart_ble_beacon_lost, 60) != value.toInt())
-            {
-                _preferences->putInt(preference_restart_ble_beacon_lost, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "TSKNTWK")
-        {
-            if (value.toInt() > 12287 && value.toInt() < 65537)
-            {
-                if (_preferences->getInt(preference_task_size_network, NETWORK_TASK_SIZE) != value.toInt())
-                {
-                    _preferences->putInt(preference_task_size_network, value.toInt());
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    configChanged = true;
-                }
-            }
-        }
-        else if (key == "TSKNUKI")
-        {
-            if (value.toInt() > 8191 && value.toInt() < 65537)
-            {
-                if (_preferences->getInt(preference_task_size_nuki, NUKI_TASK_SIZE) != value.toInt())
-                {
-                    _preferences->putInt(preference_task_size_nuki, value.toInt());
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    configChanged = true;
-                }
-            }
-        }
-        else if (key == "ALMAX")
-        {
-            if (value.toInt() > 0 && value.toInt() < 101)
-            {
-                if (_preferences->getInt(preference_authlog_max_entries, MAX_AUTHLOG) != value.toInt())
-                {
-                    _preferences->putInt(preference_authlog_max_entries, value.toInt());
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    // configChanged = true;
-                }
-            }
-        }
-        else if (key == "KPMAX")
-        {
-            if (value.toInt() > 0 && value.toInt() < 201)
-            {
-                if (_preferences->getInt(preference_keypad_max_entries, MAX_KEYPAD) != value.toInt())
-                {
-                    _preferences->putInt(preference_keypad_max_entries, value.toInt());
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    // configChanged = true;
-                }
-            }
-        }
-        else if (key == "TCMAX")
-        {
-            if (value.toInt() > 0 && value.toInt() < 101)
-            {
-                if (_preferences->getInt(preference_timecontrol_max_entries, MAX_TIMECONTROL) != value.toInt())
-                {
-                    _preferences->putInt(preference_timecontrol_max_entries, value.toInt());
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    // configChanged = true;
-                }
-            }
-        }
-        else if (key == "AUTHMAX")
-        {
-            if (value.toInt() > 0 && value.toInt() < 101)
-            {
-                if (_preferences->getInt(preference_auth_max_entries, MAX_AUTH) != value.toInt())
-                {
-                    _preferences->putInt(preference_auth_max_entries, value.toInt());
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    // configChanged = true;
-                }
-            }
-        }
-        else if (key == "BUFFSIZE")
-        {
-            if (value.toInt() > 4095 && value.toInt() < 65537)
-            {
-                if (_preferences->getInt(preference_buffer_size, CHAR_BUFFER_SIZE) != value.toInt())
-                {
-                    _preferences->putInt(preference_buffer_size, value.toInt());
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    configChanged = true;
-                }
-            }
-        }
-        else if (key == "BTLPRST")
-        {
-            if (_preferences->getBool(preference_enable_bootloop_reset, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_enable_bootloop_reset, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "SHOWSECRETS")
-        {
-            if (_preferences->getBool(preference_show_secrets, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_show_secrets, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                // configChanged = true;
-            }
-        }
-        else if (key == "DBGCONN")
-        {
-            if (_preferences->getBool(preference_debug_connect, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_debug_connect, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "DBGCOMMU")
-        {
-            if (_preferences->getBool(preference_debug_communication, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_debug_communication, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "DBGHEAP")
-        {
-            if (_preferences->getBool(preference_send_debug_info, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_send_debug_info, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "DBGREAD")
-        {
-            if (_preferences->getBool(preference_debug_readable_data, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_debug_readable_data, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "DBGHEX")
-        {
-            if (_preferences->getBool(preference_debug_hex_data, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_debug_hex_data, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "DBGCOMM")
-        {
-            if (_preferences->getBool(preference_debug_command, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_debug_command, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "LCKFORCEID")
-        {
-            if (_preferences->getBool(preference_lock_force_id, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_lock_force_id, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-            }
-        }
-        else if (key == "LCKFORCEKP")
-        {
-            if (_preferences->getBool(preference_lock_force_keypad, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_lock_force_keypad, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-            }
-        }
-        else if (key == "LCKFORCEDS")
-        {
-            if (_preferences->getBool(preference_lock_force_doorsensor, false) != (value == "1"))
-            {
-                _preferences->putBool(preference_lock_force_doorsensor, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-            }
-        }
-        else if (key == "ACLLVLCHANGED")
-        {
-            aclLvlChanged = true;
-        }
-        else if (key == "CREDDIGEST")
-        {
-            if (_preferences->getInt(preference_http_auth_type, 0) != value.toInt())
-            {
-                _preferences->putInt(preference_http_auth_type, value.toInt());
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-                clearSession = true;
-            }
-        }
-        else if (key == "CREDTRUSTPROXY")
-        {
-            if (value != "*")
-            {
-                if (_preferences->getString(preference_bypass_proxy, "") != value)
-                {
-                    _preferences->putString(preference_bypass_proxy, value);
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    configChanged = true;
-                    clearSession = true;
-                }
-            }
-        }
-        else if (key == "ACLLCKLCK")
-        {
-            aclPrefs[0] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "ACLLCKUNLCK")
-        {
-            aclPrefs[1] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "ACLLCKUNLTCH")
-        {
-            aclPrefs[2] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "ACLLCKLNG")
-        {
-            aclPrefs[3] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "ACLLCKLNGU")
-        {
-            aclPrefs[4] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "ACLLCKFLLCK")
-        {
-            aclPrefs[5] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "ACLLCKFOB1")
-        {
-            aclPrefs[6] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "ACLLCKFOB2")
-        {
-            aclPrefs[7] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "ACLLCKFOB3")
-        {
-            aclPrefs[8] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKNAME")
-        {
-            basicLockConfigAclPrefs[0] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKLAT")
-        {
-            basicLockConfigAclPrefs[1] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKLONG")
-        {
-            basicLockConfigAclPrefs[2] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKAUNL")
-        {
-            basicLockConfigAclPrefs[3] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKPRENA")
-        {
-            basicLockConfigAclPrefs[4] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKBTENA")
-        {
-            basicLockConfigAclPrefs[5] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKLEDENA")
-        {
-            basicLockConfigAclPrefs[6] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKLEDBR")
-        {
-            basicLockConfigAclPrefs[7] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKTZOFF")
-        {
-            basicLockConfigAclPrefs[8] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKDSTM")
-        {
-            basicLockConfigAclPrefs[9] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKFOB1")
-        {
-            basicLockConfigAclPrefs[10] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKFOB2")
-        {
-            basicLockConfigAclPrefs[11] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKFOB3")
-        {
-            basicLockConfigAclPrefs[12] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKSGLLCK")
-        {
-            basicLockConfigAclPrefs[13] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKADVM")
-        {
-            basicLockConfigAclPrefs[14] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKTZID")
-        {
-            basicLockConfigAclPrefs[15] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKUPOD")
-        {
-            advancedLockConfigAclPrefs[0] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKLPOD")
-        {
-            advancedLockConfigAclPrefs[1] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKSLPOD")
-        {
-            advancedLockConfigAclPrefs[2] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKUTLTOD")
-        {
-            advancedLockConfigAclPrefs[3] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKLNGT")
-        {
-            advancedLockConfigAclPrefs[4] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKSBPA")
-        {
-            advancedLockConfigAclPrefs[5] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKDBPA")
-        {
-            advancedLockConfigAclPrefs[6] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKDC")
-        {
-            advancedLockConfigAclPrefs[7] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKBATT")
-        {
-            advancedLockConfigAclPrefs[8] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKABTD")
-        {
-            advancedLockConfigAclPrefs[9] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKUNLD")
-        {
-            advancedLockConfigAclPrefs[10] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKALT")
-        {
-            advancedLockConfigAclPrefs[11] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKAUNLD")
-        {
-            advancedLockConfigAclPrefs[12] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKNMENA")
-        {
-            advancedLockConfigAclPrefs[13] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKNMST")
-        {
-            advancedLockConfigAclPrefs[14] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKNMET")
-        {
-            advancedLockConfigAclPrefs[15] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKNMALENA")
-        {
-            advancedLockConfigAclPrefs[16] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKNMAULD")
-        {
-            advancedLockConfigAclPrefs[17] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKNMLOS")
-        {
-            advancedLockConfigAclPrefs[18] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKALENA")
-        {
-            advancedLockConfigAclPrefs[19] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKIALENA")
-        {
-            advancedLockConfigAclPrefs[20] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKAUENA")
-        {
-            advancedLockConfigAclPrefs[21] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKRBTNUKI")
-        {
-            advancedLockConfigAclPrefs[22] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "CONFLCKMTRSPD")
-        {
-            advancedLockConfigAclPrefs[23] = ((value == "1") ? 1 : 0);
-        }
-        else if (key == "LOCKENA")
-        {
-            if (_preferences->getBool(preference_lock_enabled, true) != (value == "1"))
-            {
-                _preferences->putBool(preference_lock_enabled, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "CONNMODE")
-        {
-            if (_preferences->getBool(preference_connect_mode, true) != (value == "1"))
-            {
-                _preferences->putBool(preference_connect_mode, (value == "1"));
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-        }
-        else if (key == "CREDUSER")
-        {
-            if (value == "#")
-            {
-                clearCredentials = true;
-            }
-            else
-            {
-                if (_preferences->getString(preference_cred_user, "") != value)
-                {
-                    _preferences->putString(preference_cred_user, value);
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    configChanged = true;
-                    clearSession = true;
-                }
-            }
-        }
-        else if (key == "CREDPASS")
-        {
-            pass1 = value;
-        }
-        else if (key == "CREDPASSRE")
-        {
-            pass2 = value;
-        }
-        else if (key == "CREDADMIN")
-        {
-            if (value != "*")
-            {
-                if (_preferences->getString(preference_admin_secret, "") != value)
-                {
-                    _preferences->putString(preference_admin_secret, value);
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    configChanged = true;
-                }
-            }
-        }
-        else if (key == "NUKIPIN" && _nuki != nullptr)
-        {
-            if (value == "#")
-            {
-
-                message = "Nuki Lock PIN cleared";
-                _nuki->setPin(0xffff);
-
-                Log->print(F("[DEBUG] Setting changed: "));
-                Log->println(key);
-                configChanged = true;
-            }
-            else
-            {
-
-                if (_nuki->getPin() != value.toInt())
-                {
-                    message = "Nuki Lock PIN saved";
-                    _nuki->setPin(value.toInt());
-                    Log->print(F("[DEBUG] Setting changed: "));
-                    Log->println(key);
-                    configChanged = true;
-                }
-            }
-        }
-        else if (key == "LCKMANPAIR" && (value == "1"))
-        {
-            manPairLck = true;
-        }
-        else if (key == "LCKBLEADDR")
-        {
-            if (value.length() == 12)
-                for (int i = 0; i < value.length(); i += 2)
-                {
-                    currentBleAddress[(i / 2)] = std::stoi(value.substring(i, i + 2).c_str(), nullptr, 16);
-                }
-        }
-        else if (key == "LCKSECRETK")
+        else if (key == "LCKSECRETK")
         {
             if (value.length() == 64)
                 for (int i = 0; i < value.length(); i += 2)
@@ -3691,7 +2712,6 @@ bool WebCfgServer::processArgs(WebServer *server, String &message)
                     authorizationId[(i / 2)] = std::stoi(value.substring(i, i + 2).c_str(), nullptr, 16);
                 }
         }
-
         // TODO: further else if for other parameters, analogous to above...
     }
 
@@ -3842,29 +2862,20 @@ bool WebCfgServer::processLogin(WebServer *server)
             if (username == _preferences->getString(preference_cred_user, "") &&
                 password == _preferences->getString(preference_cred_password, ""))
             {
-                char buffer[33];
+                char cookie[HTTP_SESSION_COOKIE_SIZE];
                 int64_t durationLength = 60 * 60 * _preferences->getInt(preference_cred_session_lifetime_remember, 720);
 
-                for (int i = 0; i < 4; i++)
-                {
-                    snprintf(buffer + (i * 8), 9, "%08lx", (unsigned long)esp_random());
-                }
-
                 if (!server->hasArg("remember"))
                 {
                     durationLength = _preferences->getInt(preference_cred_session_lifetime, 3600);
                 }
 
-                WiFiClient &client = server->client();
-
-                server->sendHeader("Set-Cookie", "sessionId=" + String(buffer) + "; Max-Age=" + String(durationLength) + "; HttpOnly");
-
-                struct timeval time;
-                gettimeofday(&time, NULL);
-                int64_t time_us = (int64_t)time.tv_sec * 1000000L + (int64_t)time.tv_usec;
-                _httpSessions[String(buffer)] = time_us + (durationLength * 1000000L);
+                int64_t now = unixTimeUs();
+                _httpSessions.create(now + (durationLength * 1000000L), now, cookie);
                 saveSessions();
 
+                server->sendHeader("Set-Cookie", "sessionId=" + String(cookie) + "; Max-Age=" + String(durationLength) + "; HttpOnly");
+
                 return true;
             }
         }
@@ -4096,16 +3107,11 @@ void WebCfgServer::logoutSession(WebServer *server)
     server->sendHeader("Set-Cookie", "sessionId=; path=/; HttpOnly");
 
     String cookieHeader = server->header("Cookie");
-    if (cookieHeader.indexOf("sessionId=") != -1)
+    const char *cookie = sessionCookieValue(cookieHeader);
+    if (cookie != nullptr)
     {
-        int startIndex = cookieHeader.indexOf("sessionId=") + 10;
-        int endIndex = cookieHeader.indexOf(";", startIndex);
-        if (endIndex == -1)
-            endIndex = cookieHeader.length();
-        String cookie = cookieHeader.substring(startIndex, endIndex);
-
         _httpSessions.remove(cookie);
-        saveSessions();
+        saveSessions(true);
     }
     else
     {
@@ -4131,29 +3137,37 @@ const String WebCfgServer::pinStateToString(const NukiPinState &value) const
     }
 }
 
-void WebCfgServer::saveSessions()
+void WebCfgServer::saveSessions(bool immediate)
 {
-    if (_preferences->getBool(preference_update_time, false))
+    // sessions are only kept over a restart if the time is synced, the expiry is a unix time
+    if (!_httpSessions.isDirty() || !_persistSessions)
     {
-        if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
-        {
-            Log->println(F("[ERROR]LittleFS Mount Failed"));
-        }
-        else
-        {
-            File file;
-
-            file = LittleFS.open("/sessions.json", "w");
-            serializeJson(_httpSessions, file);
+        return;
+    }
+    if (!immediate && (millis() - _sessionsSavedAt) < HTTP_SESSION_SAVE_INTERVAL)
+    {
+        return; // written later from handleClient()
+    }
 
+    if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
+    {
+        Log->println(F("[ERROR] LittleFS Mount Failed"));
+    }
+    else
+    {
+        File file = LittleFS.open("/sessions.bin", "w");
+        if (file)
+        {
+            _httpSessions.write(file);
             file.close();
         }
     }
+    _sessionsSavedAt = millis();
 }
 
 void WebCfgServer::loadSessions()
 {
-    if (_preferences->getBool(preference_update_time, false))
+    if (_persistSessions)
     {
         if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
         {
@@ -4161,17 +3175,21 @@ void WebCfgServer::loadSessions()
         }
         else
         {
-            File file;
+            // sessions of the former JSON format are dropped
+            if (LittleFS.exists("/sessions.json"))
+            {
+                LittleFS.remove("/sessions.json");
+            }
 
-            file = LittleFS.open("/sessions.json", "r");
+            File file = LittleFS.open("/sessions.bin", "r");
 
             if (!file || file.isDirectory())
             {
-                Log->println(F("[WARNING] sessions.json not found"));
+                Log->println(F("[WARNING] sessions.bin not found"));
             }
-            else
+            else if (!_httpSessions.read(file))
             {
-                deserializeJson(_httpSessions, file);
+                Log->println(F("[WARNING] sessions.bin invalid, sessions dropped"));
             }
 
             file.close();
@@ -4181,16 +3199,14 @@ void WebCfgServer::loadSessions()
 
 void WebCfgServer::clearSessions()
 {
+    _httpSessions.clear();
+
     if (!LittleFS.begin(true, "/littlefs", 10, "littlefs"))
     {
         Log->println(F("[ERROR] LittleFS Mount Failed"));
     }
-    else
+    else if (LittleFS.exists("/sessions.bin"))
     {
-        _httpSessions.clear();
-        File file;
-        file = LittleFS.open("/sessions.json", "w");
-        serializeJson(_httpSessions, file);
-        file.close();
+        LittleFS.remove("/sessions.bin");
     }
 }
@@ -6,12 +6,17 @@
 #include "Config.h"
 #include "NukiWrapper.h"
 #include "NukiNetwork.h"
+#include "ChunkedResponse.hpp"
+#include "HttpSessionTable.hpp"
 #include <ArduinoJson.h>
 
 extern TaskHandle_t networkTaskHandle;
 extern TaskHandle_t nukiTaskHandle;
 extern TaskHandle_t webCfgTaskHandle;
 
+struct WebAsset;
+struct SettingField;
+
 /**
  * @brief Minimal Web Configuration Server that accepts configuration via `/` and `/save`.
  *
@@ -46,9 +51,11 @@ public:
 
 private:
     /**
-     * @brief Sends embedded CSS styling to the client.
+     * @brief Sends an embedded gzipped asset, or 304 if the client's cached copy is current.
+     * @param server Pointer to the WebServer instance.
+     * @param asset Asset to send.
      */
-    void sendCss(WebServer *server);
+    void sendWebAsset(WebServer *server, const WebAsset &asset);
 
     /**
      * @brief Issues a redirect to a different URL.
@@ -129,15 +136,29 @@ private:
     /**
      * @brief Handles HTTP request to download the current log file.
      *
-     * This method attempts to mount the LittleFS filesystem and open the current log file
-     * defined by LOGGER_FILENAME. If the file is found, it is streamed to the client
-     * with appropriate headers to trigger a download. If the file does not exist or
-     * cannot be opened, a corresponding HTTP error response is sent.
+     * Requests with query arguments (tail, since, level, grep, max) are handed to
+     * buildLogQueryResponse(). Otherwise this method mounts the LittleFS filesystem and
+     * opens the current log file (Log->getFileName()). If the file is found, it is streamed
+     * to the client with appropriate headers to trigger a download. A binary log file is
+     * converted to JSON lines on the fly unless the "raw" argument is given. If the file
+     * does not exist or cannot be opened, a corresponding HTTP error response is sent.
      *
      * @param server Pointer to the WebServer handling the current HTTP request.
      */
     void buildGetLogFileHtml(WebServer *server);
 
+    /**
+     * @brief Streams the lines of the log file selected by the query arguments.
+     *
+     * Arguments (all optional): "tail" (last n lines), "since" (uptime in seconds of
+     * the current boot), "level" (minimum level, name or number), "grep" (text the
+     * line must contain) and "max" (byte budget, default LOG_QUERY_DEFAULT_BYTES,
+     * limited to LOG_QUERY_MAX_BYTES). The result is sent as chunked JSON lines.
+     *
+     * @param server Pointer to the WebServer handling the current HTTP request.
+     */
+    void buildLogQueryResponse(WebServer *server);
+
     /**
      * @brief Builds the HTML page to download current core dump file.
      * @param server Pointer to the active WebServer instance.
@@ -180,10 +201,10 @@ private:
 
     /**
      * @brief Builds the initial HTML header including optional extra headers.
-     * @param response Reference to the HTML response string.
+     * @param response Chunked HTML response to write to.
      * @param additionalHeader Optional extra HTML to include inside <head> (e.g. CSS/JS).
      */
-    void buildHtmlHeader(String &response, const String &additionalHeader = "");
+    void buildHtmlHeader(ChunkedResponse &response, const String &additionalHeader = "");
 
     /**
      * @brief Builds the HTML page to configure Wi-Fi SSID and password.
@@ -241,6 +262,15 @@ private:
      */
     bool processArgs(WebServer *server, String &message);
 
+    /**
+     * Stores a table driven setting (see WebCfgSettingFields.h) if it changed.
+     *
+     * @param field    Descriptor of the form field.
+     * @param value    Submitted value.
+     * @return         true if the preference was changed.
+     */
+    bool applySetting(const SettingField &field, const String &value);
+
     /**
      * @brief Processes the current bypass request from the web UI.
      * @param server Pointer to the WebServer instance.
@@ -271,13 +301,13 @@ private:
 
     /**
      * @brief Appends a static parameter (read-only) row to the HTML output.
-     * @param response Reference to the HTML response string.
+     * @param response Chunked HTML response to write to.
      * @param description Label for the parameter.
      * @param value Value to display.
      * @param link Optional link associated with the value.
      * @param id Optional HTML element ID.
      */
-    void appendParameterRow(String &response,
+    void appendParameterRow(ChunkedResponse &response,
                             const char *description,
                             const char *value,
                             const char *link = "",
@@ -285,19 +315,19 @@ private:
 
     /**
      * @brief Appends a navigation menu entry (link) to the HTML.
-     * @param response Reference to the HTML response string.
+     * @param response Chunked HTML response to write to.
      * @param title Display name of the menu item.
      * @param targetPath URL path to navigate to when clicked.
      * @param warningMessage Optional JavaScript confirmation warning.
      */
-    void appendNavigationMenuEntry(String &response,
+    void appendNavigationMenuEntry(ChunkedResponse &response,
                                    const char *title,
                                    const char *targetPath,
                                    const char *warningMessage = "");
 
     /**
      * @brief Appends an input field to the HTML page.
-     * @param response Reference to the HTML response string.
+     * @param response Chunked HTML response to write to.
      * @param token Field identifier.
      * @param description Label shown next to the input.
      * @param value Pre-filled text value.
@@ -306,7 +336,7 @@ private:
      * @param isPassword True if this is a password input field.
      * @param showLengthRestriction Whether to display remaining length counter.
      */
-    void appendInputFieldRow(String &response,
+    void appendInputFieldRow(ChunkedResponse &response,
                              const char *token,
                              const char *description,
                              const char *value,
@@ -317,14 +347,14 @@ private:
 
     /**
      * @brief Appends an input field for numeric values to the HTML page.
-     * @param response Reference to the HTML response string.
+     * @param response Chunked HTML response to write to.
      * @param token Field identifier.
      * @param description Label shown next to the input.
      * @param value Numeric value.
      * @param maxLength Maximum number of digits allowed.
      * @param args Optional arguments for the input field.
      */
-    void appendInputFieldRow(String &response,
+    void appendInputFieldRow(ChunkedResponse &response,
                              const char *token,
                              const char *description,
                              const int value,
@@ -333,7 +363,7 @@ private:
 
     /**
      * @brief Appends a dropdown field (select box) to the HTML page.
-     * @param response Reference to the HTML response string.
+     * @param response Chunked HTML response to write to.
      * @param token Unique identifier (name attribute).
      * @param description Label shown next to the dropdown.
      * @param preselectedValue Currently selected option.
@@ -342,7 +372,7 @@ private:
      * @param id Optional HTML element ID.
      * @param onChange Optional JavaScript onchange handler.
      */
-    void appendDropDownRow(String &response,
+    void appendDropDownRow(ChunkedResponse &response,
                            const char *token,
                            const char *description,
                            const String preselectedValue,
@@ -353,7 +383,7 @@ private:
 
     /**
      * @brief Appends a textarea (multi-line input) field to the HTML page.
-     * @param response Reference to the HTML response string.
+     * @param response Chunked HTML response to write to.
      * @param token Unique identifier for the field.
      * @param description Label shown next to the textarea.
      * @param value Default content for the textarea.
@@ -361,7 +391,7 @@ private:
      * @param enabled Whether the field should be editable.
      * @param showLengthRestriction Display character counter.
      */
-    void appendTextareaRow(String &response,
+    void appendTextareaRow(ChunkedResponse &response,
                            const char *token,
                            const char *description,
                            const char *value,
@@ -374,82 +404,20 @@ private:
      *
      * Adds a labeled checkbox row, optionally with custom CSS class or HTML ID.
      *
-     * @param response Reference to the HTML response string.
+     * @param response Chunked HTML response to write to.
      * @param token Unique identifier (used as name and id for the checkbox).
      * @param description Label shown next to the checkbox.
      * @param value Initial checked state (true = checked).
      * @param className Optional CSS class name for the checkbox.
      * @param id Optional HTML element ID.
      */
-    void appendCheckBoxRow(String &response,
+    void appendCheckBoxRow(ChunkedResponse &response,
                            const char *token,
                            const char *description,
                            const bool value,
                            const char *className = "",
                            const char *id = "");
 
-    /**
-     * Estimate required HTML response buffer size.
-     *
-     * @param checkboxCount Number of checkbox rows (appendCheckBoxRow).
-     * @param inputFieldCount Number of input fields (appendInputFieldRow).
-     * @param dropdownCount Number of dropdown elements (appendDropDownRow / <select>).
-     * @param dropdownOptionCountTotal Total number of all dropdown options across all dropdowns (<option>).
-     * @param textareaCount Number of multiline textarea rows (appendTextareaRow).
-     * @param parameterRowCount Number of static info rows (appendParameterRow).
-     * @param buttonCount Number of buttons (<input type="button" onclick="...">)
-     * @param navigationMenuCount Number of naviagtion menus ()
-     * @param extraContentBytes Additional manually added content JS/CSS etc. size (optional).
-     * @return Estimated total length of the HTML content in bytes.
-     */
-    size_t estimateHtmlSize(
-        int checkboxCount,
-        int inputFieldCount = 0,
-        int dropdownCount = 0,
-        int dropdownOptionCountTotal = 0,
-        int textareaCount = 0,
-        int parameterRowCount = 0,
-        int buttonCount = 0,
-        int navigationMenuCount = 0,
-        int extraContentBytes = 0);
-
-    /**
-     * Reserve memory for the HTML response string using estimated layout.
-     *
-     * @param response The String object to reserve space for.
-     * @param checkboxCount Number of checkbox rows.
-     * @param inputFieldCount Number of input field rows.
-     * @param dropdownCount Number of dropdowns.
-     * @param dropdownOptionCountTotal Total number of dropdown options.
-     * @param textareaCount Number of textarea fields.
-     * @param parameterRowCount Number of static parameter/info rows.
-     * @param buttonCount Number of buttons
-     * @param navigationMenuCount Number of naviagtion menus
-     * @param extraContentBytes Additional manually added content JS/CSS etc. size (optional).
-     */
-    inline void reserveHtmlResponse(String &response,
-                                    int checkboxCount,
-                                    int inputFieldCount = 0,
-                                    int dropdownCount = 0,
-                                    int dropdownOptionCountTotal = 0,
-                                    int textareaCount = 0,
-                                    int parameterRowCount = 0,
-                                    int buttonCount = 0,
-                                    int navigationMenuCount = 0,
-                                    int extraContentBytes = 0)
-    {
-        response.reserve(estimateHtmlSize(
-            checkboxCount,
-            inputFieldCount,
-            dropdownCount,
-            dropdownOptionCountTotal,
-            textareaCount,
-            parameterRowCount,
-            buttonCount,
-            navigationMenuCount,
-            extraContentBytes));
-    }
-
     /**
      * @brief Returns network mode options for dropdowns.
      * @return Vector of value/label pairs for network mode selection.
@@ -470,9 +438,10 @@ private:
     void logoutSession(WebServer *server);
 
     /**
-     * @brief Saves the current sessions to memory or preferences.
+     * @brief Writes the session table to LittleFS if it changed, at most every HTTP_SESSION_SAVE_INTERVAL.
+     * @param immediate Skip the interval, used when a session is removed so it can't come back after a restart.
      */
-    void saveSessions();
+    void saveSessions(bool immediate = false);
 
     /**
      * @brief Loads saved sessions.
@@ -480,7 +449,7 @@ private:
     void loadSessions();
 
     /**
-     * @brief Clears all HTTP sessions.
+     * @brief Clears all HTTP sessions and deletes the session file.
      */
     void clearSessions();
 
@@ -492,7 +461,9 @@ private:
     NukiNetwork *_network = nullptr;     // Pointer to the NukiNetwork instance for connectivity control.
     Preferences *_preferences = nullptr; // Pointer to the Preferences instance for configuration storage.
     WebServer *_webServer = nullptr;     // Pointer to the internal web server instance.
-    JsonDocument _httpSessions;          // In-memory representation of active HTTP login sessions.
+    HttpSessionTable _httpSessions;      // Active HTTP login sessions.
+    bool _persistSessions = false;       // Whether sessions are kept in LittleFS over a restart.
+    unsigned long _sessionsSavedAt = 0;  // millis() of the last write of the session file.
                                          //
     bool _rebootRequired = false;        // True if a system reboot is required after saving settings.
                                          //
@@ -501,6 +472,8 @@ private:
     String _hostname;                    // Device hostname used in mDNS and web interface.
     char _credUser[31] = {0};            // Stored username for the web interface login.
     char _credPassword[31] = {0};        // Stored password for the web interface login.
+    String _bypassProxy;                 // Cached reverse proxy IP that bypasses authentication.
+    int _httpAuthType = 0;               // Cached HTTP authentication type (0=Basic, 1=Digest, 2=Form).
                                          //
     bool _allowRestartToPortal = false;  // Allows restarting into access point (config portal) mode.
 };
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Config.h"
+#include "PreferencesKeys.h"
+#include "WebCfgServerConstants.h"
+#include "LogRingBuffer.hpp"
+
+/*
+ * Settings of the web configurator that map one form field to one preference.
+ *
+ * WebCfgServer::processArgs() looks each submitted field up in this table by
+ * binary search and stores it. Fields with side effects beyond writing the
+ * preference (credentials, pairing data, log level, ...) are still handled
+ * there by hand.
+ *
+ * The table must be sorted by form key (byte order of the expanded string),
+ * this is checked at compile time.
+ */
+
+#define SETTING_RESTART 0x01 // a change requires a restart
+#define SETTING_NETWORK 0x02 // a change requires the network to be reconfigured
+#define SETTING_SESSION 0x04 // a change invalidates all web sessions
+
+enum class SettingType : uint8_t
+{
+    String,
+    Bool,
+    Int,
+    AclAction,             // flag in the lock action ACL
+    AclBasicLockConfig,    // flag in the basic lock config ACL
+    AclAdvancedLockConfig, // flag in the advanced lock config ACL
+};
+
+/**
+ * @brief Descriptor of a single form field.
+ */
+struct SettingField
+{
+    const char *key;      // Form field name
+    const char *prefKey;  // Preference key, nullptr for ACL flags
+    SettingType type;     // How the value is parsed and stored
+    int32_t defaultValue; // Default of the preference (Bool / Int), index for ACL flags
+    int32_t min;          // Smallest accepted value (Int)
+    int32_t max;          // Largest accepted value (Int)
+    uint8_t flags;        // SETTING_* flags
+};
+
+#define SETTING_STRING(KEY, PREF, FLAGS) {KEY, PREF, SettingType::String, 0, 0, 0, FLAGS}
+#define SETTING_BOOL(KEY, PREF, DEFAULT, FLAGS) {KEY, PREF, SettingType::Bool, DEFAULT, 0, 0, FLAGS}
+#define SETTING_INT(KEY, PREF, DEFAULT, FLAGS) {KEY, PREF, SettingType::Int, DEFAULT, INT32_MIN, INT32_MAX, FLAGS}
+#define SETTING_INT_RANGE(KEY, PREF, DEFAULT, MIN, MAX, FLAGS) {KEY, PREF, SettingType::Int, DEFAULT, MIN, MAX, FLAGS}
+#define SETTING_ACL(KEY, TYPE, INDEX) {KEY, nullptr, TYPE, INDEX, 0, 0, 0}
+
+static constexpr SettingField settingFields[] = {
+    SETTING_ACL("ACLLCKFLLCK", SettingType::AclAction, 5),
+    SETTING_ACL("ACLLCKFOB1", SettingType::AclAction, 6),
+    SETTING_ACL("ACLLCKFOB2", SettingType::AclAction, 7),
+    SETTING_ACL("ACLLCKFOB3", SettingType::AclAction, 8),
+    SETTING_ACL("ACLLCKLCK", SettingType::AclAction, 0),
+    SETTING_ACL("ACLLCKLNG", SettingType::AclAction, 3),
+    SETTING_ACL("ACLLCKLNGU", SettingType::AclAction, 4),
+    SETTING_ACL("ACLLCKUNLCK", SettingType::AclAction, 1),
+    SETTING_ACL("ACLLCKUNLTCH", SettingType::AclAction, 2),
+    SETTING_INT_RANGE("ALMAX", preference_authlog_max_entries, MAX_AUTHLOG, 1, 100, 0),
+    SETTING_INT_RANGE("APIEVTCLIENTS", preference_api_event_clients, EVENT_STREAM_DEFAULT_CLIENTS, 0, EVENT_STREAM_MAX_CLIENTS, SETTING_RESTART),
+    SETTING_INT("APIPORT", preference_api_port, 0, SETTING_RESTART),
+    SETTING_INT_RANGE("AUTHMAX", preference_auth_max_entries, MAX_AUTH, 1, 100, 0),
+    SETTING_INT("BATINT", preference_query_interval_battery, 1800, 0),
+    SETTING_BOOL("BTLPRST", preference_enable_bootloop_reset, false, 0),
+    SETTING_INT_RANGE("BUFFSIZE", preference_buffer_size, CHAR_BUFFER_SIZE, 4096, 65536, SETTING_RESTART),
+    SETTING_INT("CFGINT", preference_query_interval_configuration, 3600, 0),
+    SETTING_ACL("CONFLCKABTD", SettingType::AclAdvancedLockConfig, 9),
+    SETTING_ACL("CONFLCKADVM", SettingType::AclBasicLockConfig, 14),
+    SETTING_ACL("CONFLCKALENA", SettingType::AclAdvancedLockConfig, 19),
+    SETTING_ACL("CONFLCKALT", SettingType::AclAdvancedLockConfig, 11),
+    SETTING_ACL("CONFLCKAUENA", SettingType::AclAdvancedLockConfig, 21),
+    SETTING_ACL("CONFLCKAUNL", SettingType::AclBasicLockConfig, 3),
+    SETTING_ACL("CONFLCKAUNLD", SettingType::AclAdvancedLockConfig, 12),
+    SETTING_ACL("CONFLCKBATT", SettingType::AclAdvancedLockConfig, 8),
+    SETTING_ACL("CONFLCKBTENA", SettingType::AclBasicLockConfig, 5),
+    SETTING_ACL("CONFLCKDBPA", SettingType::AclAdvancedLockConfig, 6),
+    SETTING_ACL("CONFLCKDC", SettingType::AclAdvancedLockConfig, 7),
+    SETTING_ACL("CONFLCKDSTM", SettingType::AclBasicLockConfig, 9),
+    SETTING_ACL("CONFLCKFOB1", SettingType::AclBasicLockConfig, 10),
+    SETTING_ACL("CONFLCKFOB2", SettingType::AclBasicLockConfig, 11),
+    SETTING_ACL("CONFLCKFOB3", SettingType::AclBasicLockConfig, 12),
+    SETTING_ACL("CONFLCKIALENA", SettingType::AclAdvancedLockConfig, 20),
+    SETTING_ACL("CONFLCKLAT", SettingType::AclBasicLockConfig, 1),
+    SETTING_ACL("CONFLCKLEDBR", SettingType::AclBasicLockConfig, 7),
+    SETTING_ACL("CONFLCKLEDENA", SettingType::AclBasicLockConfig, 6),
+    SETTING_ACL("CONFLCKLNGT", SettingType::AclAdvancedLockConfig, 4),
+    SETTING_ACL("CONFLCKLONG", SettingType::AclBasicLockConfig, 2),
+    SETTING_ACL("CONFLCKLPOD", SettingType::AclAdvancedLockConfig, 1),
+    SETTING_ACL("CONFLCKMTRSPD", SettingType::AclAdvancedLockConfig, 23),
+    SETTING_ACL("CONFLCKNAME", SettingType::AclBasicLockConfig, 0),
+    SETTING_ACL("CONFLCKNMALENA", SettingType::AclAdvancedLockConfig, 16),
+    SETTING_ACL("CONFLCKNMAULD", SettingType::AclAdvancedLockConfig, 17),
+    SETTING_ACL("CONFLCKNMENA", SettingType::AclAdvancedLockConfig, 13),
+    SETTING_ACL("CONFLCKNMET", SettingType::AclAdvancedLockConfig, 15),
+    SETTING_ACL("CONFLCKNMLOS", SettingType::AclAdvancedLockConfig, 18),
+    SETTING_ACL("CONFLCKNMST", SettingType::AclAdvancedLockConfig, 14),
+    SETTING_ACL("CONFLCKPRENA", SettingType::AclBasicLockConfig, 4),
+    SETTING_ACL("CONFLCKRBTNUKI", SettingType::AclAdvancedLockConfig, 22),
+    SETTING_ACL("CONFLCKSBPA", SettingType::AclAdvancedLockConfig, 5),
+    SETTING_ACL("CONFLCKSGLLCK", SettingType::AclBasicLockConfig, 13),
+    SETTING_ACL("CONFLCKSLPOD", SettingType::AclAdvancedLockConfig, 2),
+    SETTING_ACL("CONFLCKTZID", SettingType::AclBasicLockConfig, 15),
+    SETTING_ACL("CONFLCKTZOFF", SettingType::AclBasicLockConfig, 8),
+    SETTING_ACL("CONFLCKUNLD", SettingType::AclAdvancedLockConfig, 10),
+    SETTING_ACL("CONFLCKUPOD", SettingType::AclAdvancedLockConfig, 0),
+    SETTING_ACL("CONFLCKUTLTOD", SettingType::AclAdvancedLockConfig, 3),
+    SETTING_BOOL("CONNMODE", preference_connect_mode, true, SETTING_RESTART),
+    SETTING_INT("CREDLFTM", preference_cred_session_lifetime, 3600, SETTING_RESTART | SETTING_SESSION),
+    SETTING_INT("CREDLFTMRMBR", preference_cred_session_lifetime_remember, 720, SETTING_RESTART | SETTING_SESSION),
+    SETTING_BOOL("DBGCOMM", preference_debug_command, false, SETTING_RESTART),
+    SETTING_BOOL("DBGCOMMU", preference_debug_communication, false, SETTING_RESTART),
+    SETTING_BOOL("DBGCONN", preference_debug_connect, false, SETTING_RESTART),
+    SETTING_BOOL("DBGHEAP", preference_send_debug_info, false, SETTING_RESTART),
+    SETTING_BOOL("DBGHEX", preference_debug_hex_data, false, SETTING_RESTART),
+    SETTING_BOOL("DBGREAD", preference_debug_readable_data, false, SETTING_RESTART),
+    SETTING_BOOL("DHCPENA", preference_ip_dhcp_enabled, true, SETTING_RESTART),
+    SETTING_STRING("DNSSRV", preference_ip_dns_server, SETTING_RESTART),
+    SETTING_BOOL("FINDBESTRSSI", preference_find_best_rssi, false, 0),
+    SETTING_STRING("HARHOST", preference_har_address, SETTING_RESTART),
+    SETTING_BOOL("HARJSON", preference_har_json_enabled, false, SETTING_RESTART),
+    SETTING_STRING("HARJSONPATH", preference_har_json_path, SETTING_RESTART),
+    SETTING_BOOL("HARKEEPALIVE", preference_har_rest_keep_alive, true, SETTING_RESTART),
+    SETTING_STRING("HARPASS", preference_har_password, SETTING_RESTART),
+    SETTING_INT("HARPORT", preference_har_port, 0, SETTING_RESTART),
+    SETTING_STRING("HARRESTMODE", preference_har_rest_mode, SETTING_RESTART),
+    SETTING_STRING("IPADDR", preference_ip_address, SETTING_RESTART),
+    SETTING_STRING("IPGTW", preference_ip_gateway, SETTING_RESTART),
+    SETTING_STRING("IPSUB", preference_ip_subnet, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_BATDRAIN, preference_har_key_battery_drain, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_BATLCKDIST, preference_har_key_battery_lock_distance, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_BATMAXTURNCUR, preference_har_key_battery_max_turn_current, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_BATVOLT, preference_har_key_battery_voltage, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_BLEADDR, preference_har_key_ble_address, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_BLERSSI, preference_har_key_ble_rssi, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_BLESTR, preference_har_key_ble_strength, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_DOORSCRIT, preference_har_key_doorsensor_critical, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_DOORSTAT, preference_har_key_doorsensor_state, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_FREEHP, preference_har_key_freeheap, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_KPCRIT, preference_har_key_keypad_critical, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_LCKBATCHRG, preference_har_key_lock_battery_charging, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_LCKBATCRIT, preference_har_key_lock_battery_critical, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_LCKBATLVL, preference_har_key_lock_battery_level, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_LCKCMPLSTAT, preference_har_key_lock_completionStatus, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_LCKNGOSTAT, preference_har_key_lockngo_state, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_LCKNMOD, preference_har_key_lock_night_mode, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_LCKSTAT, preference_har_key_lock_state, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_LCKTRIG, preference_har_key_lock_trigger, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_NBBUILD, preference_har_key_info_nuki_bridge_build, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_NBVER, preference_har_key_info_nuki_bridge_version, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_REMACCSTAT, preference_har_key_remote_access_state, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_RSTESP, preference_har_key_restart_reason_esp, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_RSTFW, preference_har_key_restart_reason_fw, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_STAT, preference_har_key_state, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_UPTM, preference_har_key_uptime, SETTING_RESTART),
+    SETTING_STRING("KEY_" TOKEN_SUFFIX_WFRSSI, preference_har_key_wifi_rssi, SETTING_RESTART),
+    SETTING_INT("KPINT", preference_query_interval_keypad, 1800, 0),
+    SETTING_INT_RANGE("KPMAX", preference_keypad_max_entries, MAX_KEYPAD, 1, 200, 0),
+    SETTING_BOOL("LCKFORCEDS", preference_lock_force_doorsensor, false, 0),
+    SETTING_BOOL("LCKFORCEID", preference_lock_force_id, false, 0),
+    SETTING_BOOL("LCKFORCEKP", preference_lock_force_keypad, false, 0),
+    SETTING_BOOL("LOCKENA", preference_lock_enabled, true, SETTING_RESTART),
+    SETTING_STRING("LOGBCKDIR", preference_log_backup_ftp_dir, SETTING_RESTART),
+    SETTING_STRING("LOGBCKPWD", preference_log_backup_ftp_pwd, SETTING_RESTART),
+    SETTING_STRING("LOGBCKSRV", preference_log_backup_ftp_server, SETTING_RESTART),
+    SETTING_STRING("LOGBCKUSR", preference_log_backup_ftp_user, SETTING_RESTART),
+    SETTING_BOOL("LOGBINARY", preference_log_binary, false, SETTING_RESTART),
+    SETTING_INT("LOGMAXSIZE", preference_log_max_file_size, 256, 0),
+    SETTING_INT_RANGE("LOGMSGLEN", preference_log_max_msg_len, 128, 1, LOG_MAX_MSG_LEN, 0),
+    SETTING_INT("LSTINT", preference_query_interval_lockstate, 1800, 0),
+    SETTING_INT("NETTIMEOUT", preference_network_timeout, 60, 0),
+    SETTING_INT("NRTRY", preference_command_nr_of_retries, 3, 0),
+    SETTING_INT("NWCUSTADDR", preference_network_custom_addr, -1, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTCLK", preference_network_custom_clk, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTCS", preference_network_custom_cs, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTIRQ", preference_network_custom_irq, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTMDC", preference_network_custom_mdc, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTMDIO", preference_network_custom_mdio, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTMISO", preference_network_custom_miso, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTMOSI", preference_network_custom_mosi, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTPHY", preference_network_custom_phy, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTPWR", preference_network_custom_pwr, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTRST", preference_network_custom_rst, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_INT("NWCUSTSCK", preference_network_custom_sck, 0, SETTING_RESTART | SETTING_NETWORK),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_BATDRAIN, preference_har_param_battery_drain, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_BATLCKDIST, preference_har_param_battery_lock_distance, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_BATMAXTURNCUR, preference_har_param_battery_max_turn_current, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_BATVOLT, preference_har_param_battery_voltage, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_BLEADDR, preference_har_param_ble_address, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_BLERSSI, preference_har_param_ble_rssi, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_BLESTR, preference_har_param_ble_strength, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_DOORSCRIT, preference_har_param_doorsensor_critical, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_DOORSTAT, preference_har_param_doorsensor_state, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_FREEHP, preference_har_param_freeheap, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_KPCRIT, preference_har_param_keypad_critical, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_LCKBATCHRG, preference_har_param_lock_battery_charging, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_LCKBATCRIT, preference_har_param_lock_battery_critical, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_LCKBATLVL, preference_har_param_lock_battery_level, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_LCKCMPLSTAT, preference_har_param_lock_completionStatus, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_LCKNGOSTAT, preference_har_param_lockngo_state, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_LCKNMOD, preference_har_param_lock_night_mode, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_LCKSTAT, preference_har_param_lock_state, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_LCKTRIG, preference_har_param_lock_trigger, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_NBBUILD, preference_har_param_info_nuki_bridge_build, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_NBVER, preference_har_param_info_nuki_bridge_version, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_REMACCSTAT, preference_har_param_remote_access_state, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_RSTESP, preference_har_param_restart_reason_esp, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_RSTFW, preference_har_param_restart_reason_fw, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_UPTM, preference_har_param_uptime, SETTING_RESTART),
+    SETTING_STRING("PARAM_" TOKEN_SUFFIX_WFRSSI, preference_har_param_wifi_rssi, SETTING_RESTART),
+    SETTING_INT("RSBC", preference_restart_ble_beacon_lost, 60, 0),
+    SETTING_INT("RSSI", preference_rssi_send_interval, 60, 0),
+    SETTING_BOOL("RSTDISC", preference_restart_on_disconnect, false, 0),
+    SETTING_BOOL("SHOWSECRETS", preference_show_secrets, false, 0),
+    SETTING_INT_RANGE("TCMAX", preference_timecontrol_max_entries, MAX_TIMECONTROL, 1, 100, 0),
+    SETTING_STRING("TIMESRV", preference_time_server, SETTING_RESTART),
+    SETTING_INT("TRYDLY", preference_command_retry_delay, 100, 0),
+    SETTING_INT_RANGE("TSKNTWK", preference_task_size_network, NETWORK_TASK_SIZE, 12288, 65536, SETTING_RESTART),
+    SETTING_INT_RANGE("TSKNUKI", preference_task_size_nuki, NUKI_TASK_SIZE, 8192, 65536, SETTING_RESTART),
+    SETTING_BOOL("UPTIME", preference_update_time, false, SETTING_RESTART),
+};
+
+#undef SETTING_STRING
+#undef SETTING_BOOL
+#undef SETTING_INT
+#undef SETTING_INT_RANGE
+#undef SETTING_ACL
+
+constexpr size_t settingFieldCount = sizeof(settingFields) / sizeof(settingFields[0]);
+
+constexpr int compareSettingKey(const char *a, const char *b)
+{
+    while (*a != '\0' && *a == *b)
+    {
+        a++;
+        b++;
+    }
+    return (int)(unsigned char)*a - (int)(unsigned char)*b;
+}
+
+constexpr bool settingFieldsSorted()
+{
+    for (size_t i = 1; i < settingFieldCount; i++)
+    {
+        if (compareSettingKey(settingFields[i - 1].key, settingFields[i].key) >= 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(settingFieldsSorted(), "settingFields must be sorted by key without duplicates");
+
+/**
+ * @brief Finds the descriptor of a form field.
+ *
+ * @param key Form field name.
+ * @return Descriptor or nullptr if the field isn't table driven.
+ */
+inline const SettingField *findSettingField(const char *key)
+{
+    size_t low = 0;
+    size_t high = settingFieldCount;
+
+    while (low < high)
+    {
+        size_t mid = (low + high) / 2;
+        int cmp = compareSettingKey(key, settingFields[mid].key);
+        if (cmp == 0)
+        {
+            return &settingFields[mid];
+        }
+        if (cmp < 0)
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+    return nullptr;
+}
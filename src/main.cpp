@@ -63,6 +63,7 @@ RestartReason currentRestartReason = RestartReason::NotApplicable; // Tracks cur
 TaskHandle_t nukiTaskHandle = nullptr;    // Handle for BLE/Nuki lock task.
 TaskHandle_t networkTaskHandle = nullptr; // Handle for network-related task.
 TaskHandle_t webCfgTaskHandle = nullptr;  // Handle for web config server task.
+TaskHandle_t restApiTaskHandle = nullptr; // Handle for REST API server task.
 
 /**
  * @brief Callback function invoked by SNTP when the time is synchronized.
@@ -282,6 +283,33 @@ void networkTask(void *parameter)
   }
 }
 
+/**
+ * @brief REST API task: processes HTTP requests to the REST API server
+ */
+void restApiTask(void *parameter)
+{
+  int64_t restApiLoopTs = 0;
+  if (!restApiLoopTs)
+    Log->println(F("[DEBUG] run restApiTask()"));
+  while (true)
+  {
+    if (network != nullptr)
+    {
+      network->handleClient();
+    }
+    if (espMillis() - restApiLoopTs > 120000)
+    {
+      Log->println(F("[DEBUG] restApiTask is running"));
+      restApiLoopTs = espMillis();
+    }
+    vTaskDelay(REST_API_POLL_INTERVAL / portTICK_PERIOD_MS);
+    if (esp_task_wdt_status(restApiTaskHandle) == ESP_OK)
+    {
+      esp_task_wdt_reset();
+    }
+  }
+}
+
 /**
  * @brief WebConfig task: processes HTTP requests to Web Configurator
  */
@@ -425,6 +453,29 @@ void setupTasks()
     {
       Log->println(F("[ERROR] Failed to create networkTas"));
     }
+
+    Log->println(F("[DEBUG] Create restApiTask"));
+    if (xTaskCreatePinnedToCore(restApiTask, "restApi", REST_API_TASK_SIZE, NULL, 3, &restApiTaskHandle, (espCores > 1) ? 1 : 0) != pdPASS)
+    {
+      Log->println(F("[ERROR] restApiTask could not be started!"));
+    }
+    Log->printf(F("[DEBUG] Created restApiTaskHandle: %p\n"), restApiTaskHandle);
+    if (restApiTaskHandle != NULL)
+    {
+      esp_err_t err = esp_task_wdt_add(restApiTaskHandle);
+      if (err != ESP_OK)
+      {
+        Log->printf(F("[ERROR] esp_task_wdt_add failed for restApiTask: %d\n"), err);
+      }
+      else
+      {
+        Log->println(F("[DEBUG] restApiTask successfully added to Watchdog"));
+      }
+    }
+    else
+    {
+      Log->println(F("[ERROR] Failed to create restApiTask"));
+    }
   }
 
   if (!network->isApOpen() && lockEnabled)
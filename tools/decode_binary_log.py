@@ -0,0 +1,116 @@
+"""Render a binary Nuki Bridge log file (nukiBridge.blog) as JSON lines.
+
+Usage: python decode_binary_log.py nukiBridge.blog [output.log]
+
+The output matches the text log format of the bridge, one JSON object with
+"timestamp", "Type" and "message" per line. See src/LogBinaryFormat.hpp for
+the record layout. Synced timestamps are rendered in UTC.
+"""
+
+import json
+import sys
+from datetime import datetime, timezone
+
+TAG_BASE = 0xF0
+TAG_TYPED = 0xF1
+LEVELS = ["TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"]
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def eof(self):
+        return self.pos >= len(self.data)
+
+    def byte(self):
+        if self.eof():
+            raise EOFError
+        value = self.data[self.pos]
+        self.pos += 1
+        return value
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self.byte()
+            value |= (byte & 0x7F) << shift
+            if not byte & 0x80:
+                return value
+            shift += 7
+
+    def string(self):
+        length = self.varint()
+        if self.pos + length > len(self.data):
+            raise EOFError
+        value = self.data[self.pos:self.pos + length].decode("utf-8", errors="replace")
+        self.pos += length
+        return value
+
+
+def format_timestamp(uptime, base_uptime, base_epoch):
+    if base_epoch:
+        seconds = base_epoch + (uptime - base_uptime) // 1000
+        return datetime.fromtimestamp(seconds, timezone.utc).strftime("%Y-%m-%dT%H:%M:%SZ")
+
+    seconds = uptime // 1000
+    days, seconds = divmod(seconds, 86400)
+    hours, seconds = divmod(seconds, 3600)
+    minutes, seconds = divmod(seconds, 60)
+    return "P%dDT%02dH%02dM%02dS" % (days, hours, minutes, seconds)
+
+
+def decode(data):
+    reader = Reader(data)
+    uptime = 0
+    base_uptime = 0
+    base_epoch = 0
+
+    try:
+        while not reader.eof():
+            tag = reader.byte()
+            if tag == TAG_BASE:
+                uptime = reader.varint()
+                base_uptime = uptime
+                base_epoch = reader.varint()
+                continue
+
+            if tag == TAG_TYPED:
+                uptime += reader.varint()
+                msg_type = reader.string()
+            elif tag < len(LEVELS):
+                uptime += reader.varint()
+                msg_type = LEVELS[tag]
+            else:
+                print("Corrupt record at offset %d, stopping" % (reader.pos - 1), file=sys.stderr)
+                return
+
+            message = reader.string()
+            yield {
+                "timestamp": format_timestamp(uptime, base_uptime, base_epoch),
+                "Type": msg_type,
+                "message": message,
+            }
+    except EOFError:
+        print("Truncated record at end of file", file=sys.stderr)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+
+    with open(sys.argv[1], "rb") as f:
+        data = f.read()
+
+    out = open(sys.argv[2], "w", encoding="utf-8") if len(sys.argv) > 2 else sys.stdout
+    for entry in decode(data):
+        out.write(json.dumps(entry, ensure_ascii=False, separators=(",", ":")) + "\n")
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
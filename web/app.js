@@ -0,0 +1,124 @@
+// Shared scripts of the web configurator, served gzipped as /app.js.
+// Pages only call the init function they need, e.g. window.onload = initStatus;
+
+// --- Status page ---
+let statusTimer = null;
+
+function updateInfo() {
+    var request = new XMLHttpRequest();
+    request.open('GET', '/get?page=status', true);
+    request.onload = () => {
+        const obj = JSON.parse(request.responseText);
+        if (obj.stop == 1) {
+            clearInterval(statusTimer);
+        }
+        for (var key of Object.keys(obj)) {
+            if (key == 'ota' && document.getElementById(key) !== null) {
+                document.getElementById(key).innerText = "<a href='/ota'>" + obj[key] + "</a>";
+            } else if (document.getElementById(key) !== null) {
+                document.getElementById(key).innerText = obj[key];
+            }
+        }
+    };
+    request.send();
+}
+
+function initStatus() {
+    updateInfo();
+    statusTimer = setInterval(updateInfo, 3000);
+}
+
+// --- Advanced configuration ---
+function calculate() {
+    var auth = document.getElementById("inputmaxauth").value;
+    var authlog = document.getElementById("inputmaxauthlog").value;
+    var keypad = document.getElementById("inputmaxkeypad").value;
+    var timecontrol = document.getElementById("inputmaxtimecontrol").value;
+    var charbuf = 0, networktask = 0;
+    var sizeauth = 300 * auth, sizeauthlog = 280 * authlog, sizekeypad = 350 * keypad, sizetimecontrol = 120 * timecontrol;
+    charbuf = Math.max(sizeauth, sizeauthlog, sizekeypad, sizetimecontrol, 4096);
+    charbuf = Math.min(charbuf, 65536);
+    networktask = Math.max(4096 + charbuf, 8192);
+    networktask = Math.min(networktask, 65536);
+    document.getElementById("mincharbuffer").innerHTML = charbuf;
+    document.getElementById("minnetworktask").innerHTML = networktask;
+}
+
+function initAdvancedConfig() {
+    ["inputmaxauthlog", "inputmaxkeypad", "inputmaxtimecontrol", "inputmaxauth"].forEach(id => {
+        document.getElementById(id).addEventListener("keyup", calculate);
+    });
+    calculate();
+}
+
+// --- Credentials ---
+function testcreds() {
+    var input_user = document.getElementById("inputuser").value;
+    var input_pass = document.getElementById("inputpass").value;
+    var input_pass2 = document.getElementById("inputpass2").value;
+    var pattern = /^[ -~]*$/;
+    if (input_user == '#' || input_user == '') { return true; }
+    if (input_pass != input_pass2) { alert('Passwords do not match'); return false; }
+    if (!pattern.test(input_user) || !pattern.test(input_pass)) { alert('Only non-unicode characters are allowed in username and password'); return false; }
+    return true;
+}
+
+// --- Home Automation configuration ---
+// Tab buttons and "tab_<name>" containers are emitted in the same order.
+function showTab(tab) {
+    document.querySelectorAll("div[id^='tab_']").forEach((div, idx) => {
+        const active = div.id === 'tab_' + tab;
+        div.style.display = active ? 'block' : 'none';
+        document.querySelectorAll('.tab-button')[idx].classList.toggle('active', active);
+    });
+}
+
+function updateHarFields() {
+    var m = document.getElementsByName('HARMODE')[0].value;
+    var u = document.getElementsByName('HARUSER')[0];
+    var p = document.getElementsByName('HARPASS')[0];
+    var r = ['RestModeRow', 'RestKeepAliveRow'].map(id => document.getElementById(id).closest('tr'));
+    var k = document.querySelectorAll('.key-row');
+    var pl = document.querySelectorAll('.param-label');
+    u.disabled = p.disabled = (m === '0');
+    r.forEach(e => e.style.display = (m === '0') ? 'none' : '');
+    k.forEach(e => e.style.display = (m === '0') ? 'none' : '');
+    pl.forEach(l => { l.innerHTML = l.innerHTML.replace(/:.*$/, m === '0' ? 'Param:' : 'Query:'); });
+}
+
+function initHarConfig() {
+    document.getElementsByName('HARMODE')[0].addEventListener('change', updateHarFields);
+    updateHarFields();
+    const first = document.querySelector("div[id^='tab_']");
+    if (first) { showTab(first.id.substring(4)); }
+}
+
+// --- Network connection (access point mode) ---
+let scanTimer = null;
+
+function updateSSID() {
+    var request = new XMLHttpRequest();
+    request.open('GET', '/ssidlist', true);
+    request.onload = () => {
+        const aplist = document.getElementById("aplist");
+        if (aplist !== null) { aplist.innerHTML = request.responseText; }
+    };
+    request.send();
+}
+
+function startScan() {
+    if (!scanTimer) { scanTimer = setInterval(updateSSID, 5000); }
+}
+
+function stopScan() {
+    if (scanTimer) { clearInterval(scanTimer); scanTimer = null; }
+}
+
+function toggleMode() {
+    const isWifi = document.getElementById('nwmode').value === '1';
+    document.getElementById('wlanConfig').style.display = isWifi ? 'block' : 'none';
+    document.getElementById('inputssid').disabled = !isWifi;
+    document.getElementById('inputpass').disabled = !isWifi;
+    document.getElementById('cbfindbestrssi').disabled = !isWifi;
+    if (isWifi) { startScan(); updateSSID(); } else { stopScan(); }
+}